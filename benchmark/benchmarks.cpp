@@ -0,0 +1,415 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ benchmarks.cpp
+
+ Performance regression benchmarks
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <ros/ros.h>
+#include <urdf/model.h>
+#include <srdfdom/model.h>
+#include <moveit/robot_model/robot_model.h>
+#include <moveit/planning_scene/planning_scene.h>
+#include <moveit/planning_interface/planning_interface.h>
+#include "filter.h"
+#include "encoder.h"
+#include "motor.h"
+#include "hardware.h"
+#include "jointTrajectoryController.h"
+#include "mpcSolver.h"
+#include "inverseKinematicsSolver.h"
+#include "inverseDynamics.h"
+#include "motionPlanningPlugin.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+// Number of precomputed inputs cycled through by each benchmark
+const size_t INPUTS = 256;
+
+// Planning group containing the actuated arm joints
+const char* PLANNING_GROUP = "arm";
+
+// Semantic description of the planning group, independent of MoveIt configuration
+const char* SEMANTIC_DESCRIPTION =
+  "<robot name=\"str1ker\">"
+  "  <group name=\"arm\">"
+  "    <joint name=\"base\"/>"
+  "    <joint name=\"upperarm_actuator\"/>"
+  "    <joint name=\"forearm_actuator\"/>"
+  "  </group>"
+  "</robot>";
+
+/*----------------------------------------------------------*\
+| Helpers
+\*----------------------------------------------------------*/
+
+// Noisy analog reading that settles between occasional jumps, same for every run
+static int getReading(size_t index)
+{
+  int level = 70 + int(index / 32 % 4) * 30;
+  int noise = int(index * 2654435761u >> 28) % 5 - 2;
+
+  return level + noise;
+}
+
+// Hardware configured from the "robot" namespace, shared by benchmarks that need it
+static hardware* getHardware(ros::NodeHandle& node)
+{
+  static unique_ptr<hardware> s_hardware;
+  static bool s_initialized = false;
+
+  if (!s_initialized)
+  {
+    s_initialized = true;
+    s_hardware.reset(new hardware(node, "robot"));
+
+    if (!s_hardware->configure() || !s_hardware->init())
+      s_hardware.reset();
+  }
+
+  return s_hardware.get();
+}
+
+/*----------------------------------------------------------*\
+| Benchmarks
+\*----------------------------------------------------------*/
+
+static void filterSample(benchmark::State& state)
+{
+  filter readings(8, 8);
+  size_t index = 0;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(readings(getReading(index++)));
+  }
+}
+
+BENCHMARK(filterSample);
+
+static void encoderFeedback(benchmark::State& state)
+{
+  ros::NodeHandle node;
+  encoder enc(node, "benchmark/encoder", "benchmark/adc", 0, -1, 70, 162, -1.5708, 1.5708, 8, 8);
+
+  vector<Adc::Ptr> readings(INPUTS);
+
+  for (size_t index = 0; index < INPUTS; index++)
+  {
+    readings[index].reset(new Adc());
+    readings[index]->adc.resize(8, 0);
+    readings[index]->adc[0] = getReading(index);
+  }
+
+  size_t index = 0;
+
+  for (auto _ : state)
+  {
+    enc.feedback(readings[index++ % INPUTS]);
+    benchmark::DoNotOptimize(enc.getPos());
+  }
+}
+
+BENCHMARK(encoderFeedback);
+
+static void motorCommand(benchmark::State& state)
+{
+  ros::NodeHandle node;
+  motor mtr(node, "benchmark/motor", "benchmark/pwm", 1, 0, 64, 255, 0.0, 3.1416);
+
+  mtr.init();
+
+  size_t index = 0;
+
+  for (auto _ : state)
+  {
+    // Alternate direction so every command is sent
+    mtr.command(index++ % 2 ? 1.5 : -1.5);
+  }
+}
+
+BENCHMARK(motorCommand);
+
+static void hardwareUpdate(benchmark::State& state)
+{
+  ros::NodeHandle node;
+  hardware* hw = getHardware(node);
+
+  if (!hw)
+  {
+    state.SkipWithError("hardware failed to initialize, load robot settings first");
+    return;
+  }
+
+  Adc::Ptr readings(new Adc());
+  readings->adc.resize(8, 0);
+  readings->quadrature.resize(2, 0);
+  readings->velocity.resize(2, 0.0f);
+
+  ros::Duration period(1.0 / hw->getRate());
+  ros::Time time(1.0);
+  size_t index = 0;
+
+  for (auto _ : state)
+  {
+    for (size_t channel = 0; channel < readings->adc.size(); channel++)
+      readings->adc[channel] = getReading(index + channel * 7);
+
+    ros::Time::setNow(time);
+    hw->feed(readings, time);
+    hw->update(time);
+
+    time += period;
+    index++;
+  }
+}
+
+BENCHMARK(hardwareUpdate);
+
+static void trajectorySample(benchmark::State& state)
+{
+  const size_t joints = 3;
+  const size_t waypoints = state.range(0);
+
+  jointTrajectoryController controller;
+  auto trajectory = make_shared<jointTrajectoryController::trajectory_t>();
+  trajectory->stride = joints + 1;
+  trajectory->joints = joints;
+  trajectory->points.resize(waypoints * trajectory->stride);
+
+  for (size_t index = 0; index < waypoints; index++)
+  {
+    double* waypoint = &trajectory->points[index * trajectory->stride];
+    waypoint[0] = index * 0.1;
+
+    for (size_t joint = 0; joint < joints; joint++)
+      waypoint[joint + 1] = sin(index * 0.1 + joint);
+  }
+
+  trajectory->start = ros::Time(1.0);
+  jointTrajectoryController::trajectory_t::ConstPtr started = trajectory;
+  controller.beginTrajectory(started);
+
+  vector<double> position(joints);
+  double duration = waypoints * 0.1;
+  size_t index = 0;
+
+  for (auto _ : state)
+  {
+    double time = duration * double(index++ % INPUTS) / INPUTS;
+    benchmark::DoNotOptimize(controller.sampleTrajectory(time, position));
+  }
+}
+
+BENCHMARK(trajectorySample)->Arg(8)->Arg(48)->Arg(512);
+
+static void mpcSolve(benchmark::State& state)
+{
+  const double step = 0.02;
+
+  // Base joint model and limits with the iteration budget under test
+  mpcSolver solver;
+  solver.init(0.05, step, 3.1416, 12.566, 1.0, 0.0, 0.001, state.range(0));
+
+  vector<double> references(INPUTS * mpcSolver::HORIZON);
+
+  for (size_t index = 0; index < INPUTS; index++)
+  {
+    for (int horizon = 0; horizon < mpcSolver::HORIZON; horizon++)
+      references[index * mpcSolver::HORIZON + horizon] = sin((index + horizon + 1) * step);
+  }
+
+  double command = 0.0;
+  size_t index = 0;
+
+  for (auto _ : state)
+  {
+    size_t input = index++ % INPUTS;
+    double position = sin(input * step) - 0.01;
+
+    command = solver.solve(
+      position, cos(input * step), command, &references[input * mpcSolver::HORIZON]);
+
+    benchmark::DoNotOptimize(command);
+  }
+}
+
+BENCHMARK(mpcSolve)->Arg(20)->Arg(40)->Arg(80);
+
+static void inverseKinematicsPosition(benchmark::State& state)
+{
+  vector<Eigen::Vector3d> targets(INPUTS);
+
+  // Reachable targets from forward kinematics over the joint ranges
+  for (size_t index = 0; index < INPUTS; index++)
+  {
+    double t = double(index) / INPUTS;
+    Eigen::MatrixXd angles((int)COUNT, 1);
+
+    angles(BASE, 0) = -1.5 + 3.0 * t;
+    angles(SHOULDER, 0) = 0.3 + 0.9 * fmod(t * 7.0, 1.0);
+    angles(ELBOW, 0) = -1.5 + 1.0 * fmod(t * 13.0, 1.0);
+    angles(WRIST, 0) = 0.0;
+
+    targets[index] = forwardKinematics(angles).translation();
+  }
+
+  size_t index = 0;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(inverseKinematics(targets[index++ % INPUTS]));
+  }
+}
+
+BENCHMARK(inverseKinematicsPosition);
+
+static void inverseDynamicsEffort(benchmark::State& state)
+{
+  urdf::Model description;
+
+  if (!description.initParam("robot_description"))
+  {
+    state.SkipWithError("robot_description not loaded");
+    return;
+  }
+
+  inverseDynamics dynamics;
+  vector<string> joints = { "base", "forearm_actuator", "solenoid", "upperarm_actuator" };
+
+  if (!dynamics.init(description, joints))
+  {
+    state.SkipWithError("no links in robot_description");
+    return;
+  }
+
+  vector<vector<double>> positions(INPUTS, vector<double>(joints.size()));
+  vector<double> velocity(joints.size(), 0.01);
+  vector<double> acceleration(joints.size(), 0.1);
+  vector<double> effort(joints.size());
+
+  // Poses over the actuator ranges
+  for (size_t index = 0; index < INPUTS; index++)
+  {
+    double t = double(index) / INPUTS;
+
+    positions[index][0] = -1.5 + 3.0 * t;
+    positions[index][1] = -0.05 * fmod(t * 7.0, 1.0);
+    positions[index][2] = 0.0;
+    positions[index][3] = -0.054 + 0.05 * fmod(t * 13.0, 1.0);
+  }
+
+  size_t index = 0;
+
+  for (auto _ : state)
+  {
+    // Full recursive Newton-Euler costs the same as gravity alone
+    dynamics.compute(positions[index++ % INPUTS], velocity, acceleration, effort);
+    benchmark::DoNotOptimize(effort.data());
+  }
+}
+
+BENCHMARK(inverseDynamicsEffort);
+
+static void planQuintic(benchmark::State& state)
+{
+  auto description = make_shared<urdf::Model>();
+
+  if (!description->initParam("robot_description"))
+  {
+    state.SkipWithError("robot_description not loaded");
+    return;
+  }
+
+  auto semantic = make_shared<srdf::Model>();
+
+  if (!semantic->initString(*description, SEMANTIC_DESCRIPTION))
+  {
+    state.SkipWithError("failed to parse planning group");
+    return;
+  }
+
+  auto model = make_shared<moveit::core::RobotModel>(description, semantic);
+  auto scene = make_shared<planning_scene::PlanningScene>(model);
+
+  scene->getCurrentStateNonConst().setToDefaultValues();
+
+  planning_interface::MotionPlanRequest request;
+  request.group_name = PLANNING_GROUP;
+  request.goal_constraints.resize(1);
+
+  for (const char* jointName : { "base", "upperarm_actuator", "forearm_actuator" })
+  {
+    const moveit::core::JointModel* joint = model->getJointModel(jointName);
+    const moveit::core::VariableBounds& bounds = joint->getVariableBounds()[0];
+
+    moveit_msgs::JointConstraint constraint;
+    constraint.joint_name = jointName;
+    constraint.position = bounds.min_position_ + (bounds.max_position_ - bounds.min_position_) * 0.75;
+    constraint.weight = 1.0;
+
+    request.goal_constraints[0].joint_constraints.push_back(constraint);
+  }
+
+  PluginContext context(PLANNING_GROUP);
+  context.setPlanningScene(scene);
+  context.setMotionPlanRequest(request);
+
+  for (auto _ : state)
+  {
+    planning_interface::MotionPlanResponse response;
+    benchmark::DoNotOptimize(context.solve(response));
+  }
+}
+
+BENCHMARK(planQuintic);
+
+/*----------------------------------------------------------*\
+| Entry point
+\*----------------------------------------------------------*/
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "benchmarks", ros::init_options::AnonymousName);
+
+  // Silence per-call informational logs that would dominate timing
+  if (ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME, ros::console::levels::Warn))
+    ros::console::notifyLoggerLevelsChanged();
+
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
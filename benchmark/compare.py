@@ -0,0 +1,66 @@
+#!/usr/bin/python3
+
+# Compares Google Benchmark JSON output against the checked in baseline.
+# Benchmarks slower than the baseline by more than the threshold are reported as regressions
+# and the script exits with a non-zero status so it can gate changes in CI.
+# When benchmarks ran with repetitions, the median of the repetitions is compared.
+# An empty baseline fails the comparison, since nothing would be gated.
+
+import argparse
+import json
+import sys
+
+# Nanoseconds per Google Benchmark time unit
+TIME_UNITS = { "ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9 }
+
+# Load benchmark times in nanoseconds keyed by benchmark name
+def load(path, metric):
+    with open(path) as file:
+        benchmarks = json.load(file).get("benchmarks", [])
+
+    # Prefer medians when repetitions were reported
+    medians = [b for b in benchmarks if b.get("aggregate_name") == "median"]
+    selected = medians if medians else [b for b in benchmarks if b.get("run_type", "iteration") == "iteration"]
+    times = {}
+
+    for benchmark in selected:
+        if benchmark.get("error_occurred"):
+            continue
+
+        name = benchmark.get("run_name", benchmark["name"])
+        times[name] = benchmark[metric] * TIME_UNITS[benchmark.get("time_unit", "ns")]
+
+    return times
+
+parser = argparse.ArgumentParser(description="Flag benchmark regressions against a baseline")
+parser.add_argument("baseline", help="baseline JSON, usually benchmark/baseline.json")
+parser.add_argument("current", help="JSON written by str1ker_benchmarks --benchmark_out")
+parser.add_argument("--threshold", type=float, default=0.1, help="allowed slowdown as a fraction (default 0.1)")
+parser.add_argument("--metric", choices=["cpu_time", "real_time"], default="cpu_time", help="time to compare")
+args = parser.parse_args()
+
+baseline = load(args.baseline, args.metric)
+current = load(args.current, args.metric)
+regressions = 0
+
+if not baseline:
+    print("%s has no benchmarks, record one by copying %s over it on the machine that runs the comparison" % (args.baseline, args.current))
+    sys.exit(1)
+
+for name in sorted(current):
+    if name not in baseline:
+        print("%-48s %12.1f ns  new" % (name, current[name]))
+        continue
+
+    change = current[name] / baseline[name] - 1.0
+    regressed = change > args.threshold
+    regressions += regressed
+
+    print("%-48s %12.1f ns  %+7.1f%%%s" % (name, current[name], change * 100.0, "  REGRESSION" if regressed else ""))
+
+for name in sorted(set(baseline) - set(current)):
+    print("%-48s %15s  missing" % (name, ""))
+
+if regressions:
+    print("%d of %d benchmarks regressed by more than %g%%" % (regressions, len(current), args.threshold * 100.0))
+    sys.exit(1)
@@ -0,0 +1,119 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ allocationCounter.cpp
+
+ Per-thread heap allocation counter
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <cstddef>
+#include <cerrno>
+#include "allocationCounter.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| Variables
+\*----------------------------------------------------------*/
+
+// Plain data so that counting never initializes anything on first use
+static thread_local uint64_t s_allocations = 0;
+static thread_local uint64_t s_frees = 0;
+
+/*----------------------------------------------------------*\
+| C library allocator
+\*----------------------------------------------------------*/
+
+extern "C"
+{
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t count, size_t size);
+  void* __libc_realloc(void* ptr, size_t size);
+  void* __libc_memalign(size_t alignment, size_t size);
+  void __libc_free(void* ptr);
+}
+
+/*----------------------------------------------------------*\
+| Allocator replacement
+\*----------------------------------------------------------*/
+
+extern "C"
+{
+
+void* malloc(size_t size)
+{
+  s_allocations++;
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+  s_allocations++;
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+  // Resizing in place still takes the allocator lock
+  s_allocations++;
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size)
+{
+  s_allocations++;
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size)
+{
+  s_allocations++;
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size)
+{
+  if (!alignment || (alignment & (alignment - 1)) || alignment % sizeof(void*))
+    return EINVAL;
+
+  s_allocations++;
+  *ptr = __libc_memalign(alignment, size);
+
+  return *ptr || !size ? 0 : ENOMEM;
+}
+
+void free(void* ptr)
+{
+  if (!ptr) return;
+
+  s_frees++;
+  __libc_free(ptr);
+}
+
+} // extern "C"
+
+/*----------------------------------------------------------*\
+| allocationCounter implementation
+\*----------------------------------------------------------*/
+
+allocationCounter::counts_t allocationCounter::get()
+{
+  return { s_allocations, s_frees };
+}
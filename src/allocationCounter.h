@@ -0,0 +1,57 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ allocationCounter.h
+
+ Per-thread heap allocation counter
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <cstdint>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| allocationCounter class
+\*----------------------------------------------------------*/
+
+//
+// Counts heap allocations made by the calling thread.
+// Linking allocationCounter.cpp into an executable replaces
+// malloc and free for the whole process, including operator new.
+//
+
+class allocationCounter
+{
+public:
+  // Allocations and frees made by one thread since it started
+  struct counts_t
+  {
+    uint64_t allocations;
+    uint64_t frees;
+  };
+
+public:
+  // Get counts for the calling thread
+  static counts_t get();
+};
+
+} // namespace str1ker
@@ -0,0 +1,72 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ channelMap.h
+
+ Firmware Channel Mapping
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| channelMap class
+\*----------------------------------------------------------*/
+
+class channelMap
+{
+private:
+  // Pin for each channel
+  const int* m_pins;
+
+  // Number of channels
+  int m_count;
+
+public:
+  channelMap(const int* pins, int count)
+    : m_pins(pins)
+    , m_count(count)
+  {
+  }
+
+public:
+  // Get number of channels
+  inline int count() const
+  {
+    return m_count;
+  }
+
+  // Determine if the channel is mapped to a pin
+  inline bool isValid(int channel) const
+  {
+    return channel >= 0 && channel < m_count;
+  }
+
+  // Get pin mapped to channel
+  inline int getPin(int channel) const
+  {
+    return m_pins[channel];
+  }
+};
+
+} // namespace str1ker
@@ -0,0 +1,304 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ firmware.cpp
+
+ Portable Analog Controller Firmware Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include "firmware.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| firmware implementation
+\*----------------------------------------------------------*/
+
+//
+// Constructor
+//
+
+firmware::firmware(hal& hardware, const firmwareConfig& config)
+  : m_hal(hardware)
+  , m_adcTopic(config.adcTopic)
+  , m_pwmTopic(config.pwmTopic)
+  , m_inputs(config.adcPins, config.adcChannels)
+  , m_outputs(config.pwmPins, config.pwmChannels)
+  , m_quadratureChannels(
+      config.quadratureChannels < MAX_QUADRATURE ? config.quadratureChannels : MAX_QUADRATURE)
+  , m_periodUs(1000000UL / config.rateHz)
+  , m_watchdogUs(config.watchdogMs * 1000UL)
+  , m_pulses(hardware, m_outputs)
+  , m_reader(m_inputBuffer, INPUT_SIZE)
+  , m_writer(m_outputBuffer, OUTPUT_SIZE + FRAME_OVERHEAD)
+  , m_configured(false)
+  , m_lastRequest(0)
+  , m_armed(false)
+  , m_timeouts(0)
+  , m_trace(0)
+  , m_traceTime(0)
+{
+}
+
+//
+// Initialization
+//
+
+void firmware::setup()
+{
+  uint32_t now = m_hal.micros();
+
+  for (int n = 0; n < MAX_READINGS; n++)
+    m_readings[n] = 0;
+
+  for (int n = 0; n < MAX_QUADRATURE; n++)
+  {
+    m_counts[n] = 0;
+    m_velocities[n] = 0.0f;
+  }
+
+  stop();
+
+  m_scheduler.add(m_periodUs, readTask, this, now);
+  m_scheduler.add(SYNC_PERIOD_US, syncTask, this, now);
+}
+
+//
+// Main loop
+//
+
+void firmware::loop()
+{
+  uint32_t now = m_hal.micros();
+
+  receive(now);
+  watchdog(now);
+  m_pulses.update(now);
+  m_scheduler.run(now);
+}
+
+//
+// Input
+//
+
+void firmware::receive(uint32_t now)
+{
+  int data;
+
+  while ((data = m_hal.receive()) >= 0)
+  {
+    if (m_reader.push(uint8_t(data))) dispatch(now);
+  }
+}
+
+void firmware::dispatch(uint32_t now)
+{
+  uint16_t topic = m_reader.getTopic();
+
+  if (topic == TOPIC_PUBLISHER && m_reader.getLength() == 0)
+  {
+    // Host requested topics
+    negotiate();
+  }
+  else if (topic == TOPIC_TX_STOP)
+  {
+    // Host disconnected
+    m_configured = false;
+    m_armed = false;
+    stop();
+  }
+  else if (topic == TOPIC_PWM)
+  {
+    uint32_t trace = 0;
+    int count = deserializePwm(
+      m_reader.getPayload(), m_reader.getLength(), m_requests, MAX_REQUESTS, trace);
+
+    // Any request, including an empty heartbeat, keeps outputs alive
+    if (count >= 0)
+    {
+      m_lastRequest = now;
+      m_armed = true;
+    }
+
+    for (int n = 0; n < count; n++)
+      write(m_requests[n], now);
+
+    // Heartbeats are not traced, keep echoing the last traced request
+    if (count > 0 && trace)
+    {
+      m_trace = trace;
+      m_traceTime = now;
+    }
+  }
+}
+
+void firmware::watchdog(uint32_t now)
+{
+  if (!m_armed || m_watchdogUs == 0) return;
+  if (now - m_lastRequest < m_watchdogUs) return;
+
+  // Host or link stalled, don't leave the last duty cycle applied
+  m_armed = false;
+  m_timeouts++;
+  stop();
+}
+
+void firmware::read(uint32_t now)
+{
+  int adcChannels = m_inputs.count() < MAX_READINGS ? m_inputs.count() : MAX_READINGS;
+
+  for (int channel = 0; channel < adcChannels; channel++)
+  {
+    m_readings[channel] = m_hal.readAnalog(m_inputs.getPin(channel));
+  }
+
+  for (int channel = 0; channel < m_quadratureChannels; channel++)
+  {
+    quadratureSample sample;
+    m_hal.readQuadrature(channel, sample);
+
+    m_counts[channel] = sample.count;
+    m_velocities[channel] = m_estimators[channel].update(sample, now);
+  }
+
+  if (!m_configured) return;
+
+  adcFrame frame;
+  frame.adc = m_readings;
+  frame.adcCount = adcChannels;
+  frame.quadrature = m_counts;
+  frame.velocity = m_velocities;
+  frame.quadratureCount = m_quadratureChannels;
+  frame.missed = m_scheduler.getMissed();
+  frame.timeouts = m_timeouts;
+  frame.trace = m_trace;
+  frame.traceDelay = m_trace ? now - m_traceTime : 0;
+
+  publish(TOPIC_ADC, serializeAdc(frame, m_writer.getPayload(), m_writer.getCapacity()));
+}
+
+//
+// Output
+//
+
+void firmware::write(const pwmRequest& request, uint32_t now)
+{
+  if (!m_outputs.isValid(request.channel)) return;
+
+  int pin = m_outputs.getPin(request.channel);
+
+  m_pulses.cancel(request.channel);
+
+  if (request.mode == MODE_DIGITAL && request.delay > 0)
+  {
+    // Write at the requested offset into the cycle instead of on arrival
+    m_pulses.schedule(
+      request.channel,
+      request.value != 0,
+      request.delay,
+      uint32_t(request.duration) * 1000UL,
+      now);
+
+    return;
+  }
+
+  if (request.mode == MODE_ANALOG)
+  {
+    // Write PWM waveform
+    m_hal.writeAnalog(pin, request.value);
+  }
+  else if (request.mode == MODE_DIGITAL)
+  {
+    // Write high or low
+    m_hal.writeDigital(pin, request.value != 0);
+  }
+
+  if (request.duration > 0)
+  {
+    // Invert after duration elapses, without blocking the loop
+    m_pulses.start(request.channel, request.value != 0, uint32_t(request.duration) * 1000UL, now);
+  }
+}
+
+void firmware::stop()
+{
+  m_pulses.cancelAll();
+
+  for (int channel = 0; channel < m_outputs.count(); channel++)
+    m_hal.writeAnalog(m_outputs.getPin(channel), 0);
+}
+
+//
+// Host protocol
+//
+
+void firmware::negotiate()
+{
+  publish(TOPIC_PUBLISHER, serializeTopicInfo(
+    TOPIC_ADC,
+    m_adcTopic,
+    ADC_TYPE,
+    ADC_MD5,
+    OUTPUT_SIZE,
+    m_writer.getPayload(),
+    m_writer.getCapacity()));
+
+  publish(TOPIC_SUBSCRIBER, serializeTopicInfo(
+    TOPIC_PWM,
+    m_pwmTopic,
+    PWM_TYPE,
+    PWM_MD5,
+    INPUT_SIZE,
+    m_writer.getPayload(),
+    m_writer.getCapacity()));
+
+  // Host expects a time request to complete the handshake
+  publish(TOPIC_TIME, serializeTime(0, 0, m_writer.getPayload(), m_writer.getCapacity()));
+
+  m_configured = true;
+}
+
+void firmware::publish(uint16_t topic, int length)
+{
+  if (length < 0) return;
+
+  int size = m_writer.finish(topic, length);
+  m_hal.send(m_writer.getFrame(), size);
+}
+
+//
+// Tasks
+//
+
+void firmware::readTask(void* context, uint32_t now)
+{
+  static_cast<firmware*>(context)->read(now);
+}
+
+void firmware::syncTask(void* context, uint32_t)
+{
+  firmware* self = static_cast<firmware*>(context);
+
+  if (!self->m_configured) return;
+
+  // Keep host from declaring the device lost
+  self->publish(TOPIC_TIME, serializeTime(
+    0, 0, self->m_writer.getPayload(), self->m_writer.getCapacity()));
+}
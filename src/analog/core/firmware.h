@@ -0,0 +1,223 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ firmware.h
+
+ Portable Analog Controller Firmware
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+#include "hal.h"
+#include "channelMap.h"
+#include "framing.h"
+#include "messages.h"
+#include "scheduler.h"
+#include "pulseEngine.h"
+#include "velocityEstimator.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| firmwareConfig struct
+\*----------------------------------------------------------*/
+
+struct firmwareConfig
+{
+  // Topic for publishing analog readings
+  const char* adcTopic;
+
+  // Topic for receiving output requests
+  const char* pwmTopic;
+
+  // Analog input pins
+  const int* adcPins;
+  int adcChannels;
+
+  // Output pins
+  const int* pwmPins;
+  int pwmChannels;
+
+  // Number of quadrature encoders
+  int quadratureChannels;
+
+  // Readings publish rate
+  uint32_t rateHz;
+
+  // Turn off outputs if no output request arrives within timeout (0 disables)
+  uint32_t watchdogMs;
+};
+
+/*----------------------------------------------------------*\
+| firmware class
+\*----------------------------------------------------------*/
+
+class firmware
+{
+private:
+  // Maximum number of analog readings published per frame
+  static const int MAX_READINGS = 16;
+
+  // Maximum number of quadrature encoders
+  static const int MAX_QUADRATURE = 4;
+
+  // Maximum number of output requests per frame
+  static const int MAX_REQUESTS = 16;
+
+  // Payload buffer sizes advertised to host
+  static const int INPUT_SIZE = 128;
+  static const int OUTPUT_SIZE = 128;
+
+  // Host considers device lost after 15 seconds without time requests
+  static const uint32_t SYNC_PERIOD_US = 2500000;
+
+private:
+  //
+  // Configuration
+  //
+
+  // Hardware interface
+  hal& m_hal;
+
+  // Topic names
+  const char* m_adcTopic;
+  const char* m_pwmTopic;
+
+  // Analog input channels
+  channelMap m_inputs;
+
+  // Output channels
+  channelMap m_outputs;
+
+  // Number of quadrature encoders
+  int m_quadratureChannels;
+
+  // Readings publish period
+  uint32_t m_periodUs;
+
+  // Output request timeout
+  uint32_t m_watchdogUs;
+
+  //
+  // State
+  //
+
+  // Periodic tasks
+  scheduler m_scheduler;
+
+  // Timed digital outputs
+  pulseEngine m_pulses;
+
+  // Receive buffer and parser
+  uint8_t m_inputBuffer[INPUT_SIZE];
+  frameReader m_reader;
+
+  // Transmit buffer and serializer
+  uint8_t m_outputBuffer[OUTPUT_SIZE + FRAME_OVERHEAD];
+  frameWriter m_writer;
+
+  // Last analog readings
+  int16_t m_readings[MAX_READINGS];
+
+  // Last quadrature counts
+  int32_t m_counts[MAX_QUADRATURE];
+
+  // Last quadrature velocities
+  float m_velocities[MAX_QUADRATURE];
+
+  // Velocity estimators for each quadrature encoder
+  velocityEstimator m_estimators[MAX_QUADRATURE];
+
+  // Last output requests
+  pwmRequest m_requests[MAX_REQUESTS];
+
+  // Whether host negotiated topics
+  bool m_configured;
+
+  // Time of last output request
+  uint32_t m_lastRequest;
+
+  // Whether outputs may be on and the watchdog is counting
+  bool m_armed;
+
+  // Times the watchdog turned off outputs
+  uint32_t m_timeouts;
+
+  // Correlation ID of the last traced request, echoed in readings
+  uint32_t m_trace;
+
+  // Time the last traced request was applied
+  uint32_t m_traceTime;
+
+public:
+  firmware(hal& hardware, const firmwareConfig& config);
+
+public:
+  // Initialize outputs and tasks
+  void setup();
+
+  // Service serial port, tasks and pulses without blocking
+  void loop();
+
+  // Determine if host negotiated topics
+  inline bool isConfigured() const
+  {
+    return m_configured;
+  }
+
+  // Get number of times the watchdog turned off outputs
+  inline uint32_t getTimeouts() const
+  {
+    return m_timeouts;
+  }
+
+private:
+  // Parse incoming bytes
+  void receive(uint32_t now);
+
+  // Handle complete frame
+  void dispatch(uint32_t now);
+
+  // Turn off outputs if host stopped sending requests
+  void watchdog(uint32_t now);
+
+  // Describe topics to host
+  void negotiate();
+
+  // Send serialized payload
+  void publish(uint16_t topic, int length);
+
+  // Read and publish inputs
+  void read(uint32_t now);
+
+  // Apply output request
+  void write(const pwmRequest& request, uint32_t now);
+
+  // Turn off all outputs
+  void stop();
+
+private:
+  // Scheduler callbacks
+  static void readTask(void* context, uint32_t now);
+  static void syncTask(void* context, uint32_t now);
+};
+
+} // namespace str1ker
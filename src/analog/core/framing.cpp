@@ -0,0 +1,158 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ framing.cpp
+
+ Serial Framing Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include "framing.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| frameReader implementation
+\*----------------------------------------------------------*/
+
+frameReader::frameReader(uint8_t* buffer, int capacity)
+  : m_buffer(buffer)
+  , m_capacity(capacity)
+  , m_state(SYNC)
+  , m_length(0)
+  , m_received(0)
+  , m_topic(0)
+  , m_checksum(0)
+  , m_errors(0)
+{
+}
+
+void frameReader::reset()
+{
+  m_state = SYNC;
+}
+
+bool frameReader::push(uint8_t data)
+{
+  switch (m_state)
+  {
+    case SYNC:
+      if (data == FRAME_SYNC) m_state = PROTOCOL;
+      break;
+
+    case PROTOCOL:
+      // Tolerate repeated sync bytes while waiting for protocol
+      if (data == FRAME_PROTOCOL)
+        m_state = LENGTH_LOW;
+      else if (data != FRAME_SYNC)
+        m_state = SYNC;
+      break;
+
+    case LENGTH_LOW:
+      m_length = data;
+      m_checksum = data;
+      m_state = LENGTH_HIGH;
+      break;
+
+    case LENGTH_HIGH:
+      m_length |= int(data) << 8;
+      m_checksum += data;
+      m_state = LENGTH_CHECKSUM;
+      break;
+
+    case LENGTH_CHECKSUM:
+      m_checksum += data;
+
+      if ((m_checksum & 0xff) != 0xff || m_length > m_capacity)
+      {
+        // Corrupt or oversized frame
+        m_errors++;
+        m_state = SYNC;
+      }
+      else
+      {
+        m_state = TOPIC_LOW;
+      }
+      break;
+
+    case TOPIC_LOW:
+      m_topic = data;
+      m_checksum = data;
+      m_state = TOPIC_HIGH;
+      break;
+
+    case TOPIC_HIGH:
+      m_topic |= uint16_t(data) << 8;
+      m_checksum += data;
+      m_received = 0;
+      m_state = m_length ? PAYLOAD : PAYLOAD_CHECKSUM;
+      break;
+
+    case PAYLOAD:
+      m_buffer[m_received++] = data;
+      m_checksum += data;
+      if (m_received == m_length) m_state = PAYLOAD_CHECKSUM;
+      break;
+
+    case PAYLOAD_CHECKSUM:
+      m_checksum += data;
+      m_state = SYNC;
+
+      if ((m_checksum & 0xff) == 0xff) return true;
+
+      m_errors++;
+      break;
+  }
+
+  return false;
+}
+
+/*----------------------------------------------------------*\
+| frameWriter implementation
+\*----------------------------------------------------------*/
+
+frameWriter::frameWriter(uint8_t* buffer, int capacity)
+  : m_buffer(buffer)
+  , m_capacity(capacity)
+{
+}
+
+int frameWriter::finish(uint16_t topic, int length)
+{
+  uint8_t lengthLow = uint8_t(length & 0xff);
+  uint8_t lengthHigh = uint8_t(length >> 8);
+
+  m_buffer[0] = FRAME_SYNC;
+  m_buffer[1] = FRAME_PROTOCOL;
+  m_buffer[2] = lengthLow;
+  m_buffer[3] = lengthHigh;
+  m_buffer[4] = uint8_t(255 - ((lengthLow + lengthHigh) % 256));
+  m_buffer[5] = uint8_t(topic & 0xff);
+  m_buffer[6] = uint8_t(topic >> 8);
+
+  uint16_t checksum = m_buffer[5] + m_buffer[6];
+  const uint8_t* payload = getPayload();
+
+  for (int n = 0; n < length; n++)
+    checksum += payload[n];
+
+  m_buffer[FRAME_HEADER_SIZE + length] = uint8_t(255 - (checksum % 256));
+
+  return length + FRAME_OVERHEAD;
+}
@@ -0,0 +1,162 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ framing.h
+
+ Serial Framing compatible with rosserial protocol
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+// Frame layout: 0xff, protocol, length (2), length checksum,
+// topic (2), payload, payload checksum
+const uint8_t FRAME_SYNC = 0xff;
+const uint8_t FRAME_PROTOCOL = 0xfe;
+const int FRAME_HEADER_SIZE = 7;
+const int FRAME_OVERHEAD = FRAME_HEADER_SIZE + 1;
+
+/*----------------------------------------------------------*\
+| frameReader class
+\*----------------------------------------------------------*/
+
+class frameReader
+{
+private:
+  enum readerState
+  {
+    SYNC,
+    PROTOCOL,
+    LENGTH_LOW,
+    LENGTH_HIGH,
+    LENGTH_CHECKSUM,
+    TOPIC_LOW,
+    TOPIC_HIGH,
+    PAYLOAD,
+    PAYLOAD_CHECKSUM
+  };
+
+private:
+  // Payload buffer
+  uint8_t* m_buffer;
+
+  // Payload buffer size
+  int m_capacity;
+
+  // Current parser state
+  readerState m_state;
+
+  // Payload length of the frame being received
+  int m_length;
+
+  // Payload bytes received so far
+  int m_received;
+
+  // Topic of the frame being received
+  uint16_t m_topic;
+
+  // Running checksum
+  uint16_t m_checksum;
+
+  // Frames dropped due to checksum or size errors
+  uint16_t m_errors;
+
+public:
+  frameReader(uint8_t* buffer, int capacity);
+
+public:
+  // Feed received byte, returns true when a valid frame is complete
+  bool push(uint8_t data);
+
+  // Reset to wait for next frame
+  void reset();
+
+  // Get topic of last complete frame
+  inline uint16_t getTopic() const
+  {
+    return m_topic;
+  }
+
+  // Get payload of last complete frame
+  inline const uint8_t* getPayload() const
+  {
+    return m_buffer;
+  }
+
+  // Get payload length of last complete frame
+  inline int getLength() const
+  {
+    return m_length;
+  }
+
+  // Get number of frames dropped
+  inline uint16_t getErrors() const
+  {
+    return m_errors;
+  }
+};
+
+/*----------------------------------------------------------*\
+| frameWriter class
+\*----------------------------------------------------------*/
+
+class frameWriter
+{
+private:
+  // Frame buffer including header and checksum
+  uint8_t* m_buffer;
+
+  // Frame buffer size
+  int m_capacity;
+
+public:
+  frameWriter(uint8_t* buffer, int capacity);
+
+public:
+  // Get payload area to serialize into
+  inline uint8_t* getPayload()
+  {
+    return m_buffer + FRAME_HEADER_SIZE;
+  }
+
+  // Get payload area size
+  inline int getCapacity() const
+  {
+    return m_capacity - FRAME_OVERHEAD;
+  }
+
+  // Get frame buffer
+  inline const uint8_t* getFrame() const
+  {
+    return m_buffer;
+  }
+
+  // Write header and checksum around serialized payload, returns frame size
+  int finish(uint16_t topic, int length);
+};
+
+} // namespace str1ker
@@ -0,0 +1,78 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ hal.h
+
+ Firmware Hardware Abstraction Layer
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+#include "quadratureDecoder.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| hal class
+\*----------------------------------------------------------*/
+
+class hal
+{
+public:
+  //
+  // Time
+  //
+
+  // Microseconds since startup, wraps around every ~71 minutes
+  virtual uint32_t micros() = 0;
+
+  //
+  // Inputs
+  //
+
+  // Read analog input pin
+  virtual int16_t readAnalog(int pin) = 0;
+
+  // Read quadrature encoder state atomically
+  virtual void readQuadrature(int channel, quadratureSample& sample) = 0;
+
+  //
+  // Outputs
+  //
+
+  // Write PWM duty cycle to output pin
+  virtual void writeAnalog(int pin, uint16_t value) = 0;
+
+  // Write high or low to output pin
+  virtual void writeDigital(int pin, bool value) = 0;
+
+  //
+  // Serial
+  //
+
+  // Read next byte from serial port, or -1 if none available
+  virtual int receive() = 0;
+
+  // Write bytes to serial port
+  virtual void send(const uint8_t* data, int length) = 0;
+};
+
+} // namespace str1ker
@@ -0,0 +1,172 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ messages.cpp
+
+ Firmware Message Serialization Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <string.h>
+#include "messages.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| Helpers
+\*----------------------------------------------------------*/
+
+// Little-endian writers matching ROS serialization
+
+static inline uint8_t* writeUint16(uint8_t* pos, uint16_t value)
+{
+  pos[0] = uint8_t(value & 0xff);
+  pos[1] = uint8_t(value >> 8);
+  return pos + 2;
+}
+
+static inline uint8_t* writeUint32(uint8_t* pos, uint32_t value)
+{
+  pos[0] = uint8_t(value & 0xff);
+  pos[1] = uint8_t((value >> 8) & 0xff);
+  pos[2] = uint8_t((value >> 16) & 0xff);
+  pos[3] = uint8_t(value >> 24);
+  return pos + 4;
+}
+
+static inline uint8_t* writeFloat(uint8_t* pos, float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return writeUint32(pos, bits);
+}
+
+static inline uint8_t* writeString(uint8_t* pos, const char* value, int length)
+{
+  pos = writeUint32(pos, uint32_t(length));
+  memcpy(pos, value, length);
+  return pos + length;
+}
+
+static inline uint16_t readUint16(const uint8_t* pos)
+{
+  return uint16_t(pos[0]) | (uint16_t(pos[1]) << 8);
+}
+
+static inline uint32_t readUint32(const uint8_t* pos)
+{
+  return uint32_t(pos[0]) |
+    (uint32_t(pos[1]) << 8) |
+    (uint32_t(pos[2]) << 16) |
+    (uint32_t(pos[3]) << 24);
+}
+
+/*----------------------------------------------------------*\
+| Functions
+\*----------------------------------------------------------*/
+
+int str1ker::serializeAdc(const adcFrame& frame, uint8_t* buffer, int capacity)
+{
+  int length = 4 + frame.adcCount * 2 + 4 + frame.quadratureCount * 4 + 4 + frame.quadratureCount * 4 + 16;
+  if (length > capacity) return -1;
+
+  uint8_t* pos = writeUint32(buffer, uint32_t(frame.adcCount));
+
+  for (int n = 0; n < frame.adcCount; n++)
+    pos = writeUint16(pos, uint16_t(frame.adc[n]));
+
+  pos = writeUint32(pos, uint32_t(frame.quadratureCount));
+
+  for (int n = 0; n < frame.quadratureCount; n++)
+    pos = writeUint32(pos, uint32_t(frame.quadrature[n]));
+
+  pos = writeUint32(pos, uint32_t(frame.quadratureCount));
+
+  for (int n = 0; n < frame.quadratureCount; n++)
+    pos = writeFloat(pos, frame.velocity[n]);
+
+  pos = writeUint32(pos, frame.missed);
+  pos = writeUint32(pos, frame.timeouts);
+  pos = writeUint32(pos, frame.trace);
+  writeUint32(pos, frame.traceDelay);
+
+  return length;
+}
+
+int str1ker::deserializePwm(
+  const uint8_t* payload, int length, pwmRequest* requests, int capacity, uint32_t& trace)
+{
+  const int CHANNEL_SIZE = 7;
+
+  if (length < 4) return -1;
+
+  uint32_t count = readUint32(payload);
+  if (count > uint32_t(capacity)) return -1;
+  if (length < int(4 + count * CHANNEL_SIZE + 4)) return -1;
+
+  const uint8_t* pos = payload + 4;
+
+  for (uint32_t n = 0; n < count; n++)
+  {
+    requests[n].channel = pos[0];
+    requests[n].mode = pos[1];
+    requests[n].value = readUint16(pos + 2);
+    requests[n].duration = pos[4];
+    requests[n].delay = readUint16(pos + 5);
+    pos += CHANNEL_SIZE;
+  }
+
+  trace = readUint32(pos);
+
+  return int(count);
+}
+
+int str1ker::serializeTopicInfo(
+  uint16_t topic,
+  const char* name,
+  const char* type,
+  const char* md5,
+  int32_t bufferSize,
+  uint8_t* buffer,
+  int capacity)
+{
+  int nameLength = strlen(name);
+  int typeLength = strlen(type);
+  int md5Length = strlen(md5);
+  int length = 2 + 4 + nameLength + 4 + typeLength + 4 + md5Length + 4;
+
+  if (length > capacity) return -1;
+
+  uint8_t* pos = writeUint16(buffer, topic);
+  pos = writeString(pos, name, nameLength);
+  pos = writeString(pos, type, typeLength);
+  pos = writeString(pos, md5, md5Length);
+  writeUint32(pos, uint32_t(bufferSize));
+
+  return length;
+}
+
+int str1ker::serializeTime(uint32_t sec, uint32_t nsec, uint8_t* buffer, int capacity)
+{
+  if (capacity < 8) return -1;
+
+  writeUint32(writeUint32(buffer, sec), nsec);
+
+  return 8;
+}
@@ -0,0 +1,123 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ messages.h
+
+ Firmware Message Serialization
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+//
+// Reserved topics
+//
+
+const uint16_t TOPIC_PUBLISHER = 0;
+const uint16_t TOPIC_SUBSCRIBER = 1;
+const uint16_t TOPIC_TIME = 10;
+const uint16_t TOPIC_TX_STOP = 11;
+
+//
+// Application topics
+//
+
+const uint16_t TOPIC_ADC = 100;
+const uint16_t TOPIC_PWM = 101;
+
+//
+// Message types (MD5 must match generated messages in msg/)
+//
+
+const char ADC_TYPE[] = "str1ker/Adc";
+const char ADC_MD5[] = "8a853e5ae90dc1937a81764cabcfb504";
+const char PWM_TYPE[] = "str1ker/Pwm";
+const char PWM_MD5[] = "4ee4199402cc9f2ec7f88e5d5ca29582";
+
+//
+// PWM channel modes
+//
+
+const uint8_t MODE_ANALOG = 0;
+const uint8_t MODE_DIGITAL = 1;
+
+/*----------------------------------------------------------*\
+| Types
+\*----------------------------------------------------------*/
+
+// Analog readings published to host (str1ker/Adc)
+struct adcFrame
+{
+  const int16_t* adc;
+  int adcCount;
+
+  const int32_t* quadrature;
+  const float* velocity;
+  int quadratureCount;
+
+  uint32_t missed;
+  uint32_t timeouts;
+
+  uint32_t trace;
+  uint32_t traceDelay;
+};
+
+// Output request received from host (str1ker/PwmChannel)
+struct pwmRequest
+{
+  uint8_t channel;
+  uint8_t mode;
+  uint16_t value;
+  uint8_t duration;
+  uint16_t delay;
+};
+
+/*----------------------------------------------------------*\
+| Functions
+\*----------------------------------------------------------*/
+
+// Serialize analog readings, returns payload length or -1 if too large
+int serializeAdc(const adcFrame& frame, uint8_t* buffer, int capacity);
+
+// Deserialize output requests and correlation ID, returns request count or -1 if malformed
+int deserializePwm(
+  const uint8_t* payload, int length, pwmRequest* requests, int capacity, uint32_t& trace);
+
+// Serialize topic description for negotiation, returns payload length or -1
+int serializeTopicInfo(
+  uint16_t topic,
+  const char* name,
+  const char* type,
+  const char* md5,
+  int32_t bufferSize,
+  uint8_t* buffer,
+  int capacity);
+
+// Serialize time request, returns payload length or -1
+int serializeTime(uint32_t sec, uint32_t nsec, uint8_t* buffer, int capacity);
+
+} // namespace str1ker
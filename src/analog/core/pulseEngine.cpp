@@ -0,0 +1,103 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ pulseEngine.cpp
+
+ Firmware Non-blocking Pulse Engine Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include "scheduler.h"
+#include "pulseEngine.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| pulseEngine implementation
+\*----------------------------------------------------------*/
+
+pulseEngine::pulseEngine(hal& hardware, const channelMap& outputs)
+  : m_hal(hardware)
+  , m_outputs(outputs)
+{
+  cancelAll();
+}
+
+void pulseEngine::start(int channel, bool value, uint32_t durationUs, uint32_t now)
+{
+  if (!m_outputs.isValid(channel) || channel >= MAX_CHANNELS) return;
+
+  pulse_t& pulse = m_pulses[channel];
+  pulse.active = true;
+  pulse.pending = false;
+  pulse.restore = !value;
+  pulse.end = now + durationUs;
+}
+
+void pulseEngine::schedule(int channel, bool value, uint32_t delayUs, uint32_t durationUs, uint32_t now)
+{
+  if (!m_outputs.isValid(channel) || channel >= MAX_CHANNELS) return;
+
+  pulse_t& pulse = m_pulses[channel];
+  pulse.active = false;
+  pulse.pending = true;
+  pulse.value = value;
+  pulse.restore = !value;
+  pulse.begin = now + delayUs;
+  pulse.duration = durationUs;
+}
+
+void pulseEngine::cancel(int channel)
+{
+  if (channel >= 0 && channel < MAX_CHANNELS)
+    m_pulses[channel].active = m_pulses[channel].pending = false;
+}
+
+void pulseEngine::cancelAll()
+{
+  for (int channel = 0; channel < MAX_CHANNELS; channel++)
+    m_pulses[channel].active = m_pulses[channel].pending = false;
+}
+
+void pulseEngine::update(uint32_t now)
+{
+  for (int channel = 0; channel < m_outputs.count() && channel < MAX_CHANNELS; channel++)
+  {
+    pulse_t& pulse = m_pulses[channel];
+
+    if (pulse.pending && scheduler::isDue(now, pulse.begin))
+    {
+      pulse.pending = false;
+      m_hal.writeDigital(m_outputs.getPin(channel), pulse.value);
+
+      // Time the pulse from its scheduled start so loop jitter does not stretch it
+      if (pulse.duration > 0)
+      {
+        pulse.active = true;
+        pulse.end = pulse.begin + pulse.duration;
+      }
+    }
+
+    if (pulse.active && scheduler::isDue(now, pulse.end))
+    {
+      pulse.active = false;
+      m_hal.writeDigital(m_outputs.getPin(channel), pulse.restore);
+    }
+  }
+}
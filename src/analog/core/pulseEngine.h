@@ -0,0 +1,105 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ pulseEngine.h
+
+ Firmware Non-blocking Pulse Engine
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+#include "hal.h"
+#include "channelMap.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| pulseEngine class
+\*----------------------------------------------------------*/
+
+class pulseEngine
+{
+public:
+  // Maximum number of output channels that can pulse at once
+  static const int MAX_CHANNELS = 16;
+
+private:
+  struct pulse_t
+  {
+    // Whether the pulse is in progress
+    bool active;
+
+    // Whether the pulse is waiting to start
+    bool pending;
+
+    // Value to write when the pulse starts
+    bool value;
+
+    // Value to write when the pulse ends
+    bool restore;
+
+    // Time when the pulse starts
+    uint32_t begin;
+
+    // Time when the pulse ends
+    uint32_t end;
+
+    // Pulse duration, 0 to leave the value written
+    uint32_t duration;
+  };
+
+private:
+  // Hardware interface
+  hal& m_hal;
+
+  // Output channel mapping
+  const channelMap& m_outputs;
+
+  // Pulse state for each channel
+  pulse_t m_pulses[MAX_CHANNELS];
+
+public:
+  pulseEngine(hal& hardware, const channelMap& outputs);
+
+public:
+  // Invert the output after duration without blocking
+  void start(int channel, bool value, uint32_t durationUs, uint32_t now);
+
+  // Write the output after delay and invert it after duration, without blocking
+  void schedule(int channel, bool value, uint32_t delayUs, uint32_t durationUs, uint32_t now);
+
+  // Stop tracking a pulse without touching the output
+  void cancel(int channel);
+
+  // Stop tracking all pulses
+  void cancelAll();
+
+  // End pulses that expired
+  void update(uint32_t now);
+
+  // Determine if a pulse is in progress or waiting to start
+  inline bool isActive(int channel) const
+  {
+    return m_pulses[channel].active || m_pulses[channel].pending;
+  }
+};
+
+} // namespace str1ker
@@ -0,0 +1,130 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ quadratureDecoder.cpp
+
+ Interrupt-Driven Quadrature Decoder Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include "quadratureDecoder.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+// Count change indexed by (previous state << 2) | state, 2 = invalid
+static const int8_t TRANSITIONS[16] =
+{
+   0, -1,  1,  2,
+   1,  0,  2, -1,
+  -1,  2,  0,  1,
+   2,  1, -1,  0
+};
+
+/*----------------------------------------------------------*\
+| quadratureDecoder implementation
+\*----------------------------------------------------------*/
+
+//
+// Constructor
+//
+
+quadratureDecoder::quadratureDecoder(uint32_t minIntervalUs)
+  : m_minInterval(minIntervalUs)
+  , m_state(0)
+  , m_count(0)
+  , m_lastEdge(0)
+  , m_interval(0)
+  , m_direction(0)
+  , m_errors(0)
+  , m_glitches(0)
+{
+}
+
+//
+// Initialization
+//
+
+void quadratureDecoder::begin(bool a, bool b)
+{
+  m_state = (uint8_t(a) << 1) | uint8_t(b);
+}
+
+//
+// Interrupt handler
+//
+
+void quadratureDecoder::edge(bool a, bool b, uint32_t now)
+{
+  uint8_t state = (uint8_t(a) << 1) | uint8_t(b);
+  int8_t change = TRANSITIONS[(m_state << 2) | state];
+
+  m_state = state;
+
+  if (change == 0) return;
+
+  if (change == 2)
+  {
+    // Missed an edge, direction unknown
+    m_errors++;
+    m_interval = 0;
+    return;
+  }
+
+  // Always follow the state table so bounce cancels out in the count
+  m_count += change;
+
+  uint32_t interval = now - m_lastEdge;
+
+  if (change != m_direction)
+  {
+    // Reversal: a period measurement across it is meaningless
+    if (m_direction != 0 && interval < m_minInterval) m_glitches++;
+
+    m_interval = 0;
+  }
+  else if (interval >= m_minInterval)
+  {
+    m_interval = interval;
+  }
+  else
+  {
+    // Too fast to be real, keep the previous period
+    m_glitches++;
+    return;
+  }
+
+  m_direction = change;
+  m_lastEdge = now;
+}
+
+//
+// Sampling
+//
+
+void quadratureDecoder::sample(quadratureSample& sample) const
+{
+  sample.count = m_count;
+  sample.lastEdge = m_lastEdge;
+  sample.interval = m_interval;
+  sample.direction = m_direction;
+}
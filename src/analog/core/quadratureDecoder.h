@@ -0,0 +1,112 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ quadratureDecoder.h
+
+ Interrupt-Driven Quadrature Decoder
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| quadratureSample struct
+\*----------------------------------------------------------*/
+
+struct quadratureSample
+{
+  // Accumulated count
+  int32_t count;
+
+  // Time of the last accepted edge
+  uint32_t lastEdge;
+
+  // Time between the last two edges in the same direction, 0 if unknown
+  uint32_t interval;
+
+  // Direction of the last edge: 1, -1 or 0 if none yet
+  int8_t direction;
+};
+
+/*----------------------------------------------------------*\
+| quadratureDecoder class
+\*----------------------------------------------------------*/
+
+class quadratureDecoder
+{
+private:
+  // Default minimum time between edges considered real
+  static const uint32_t DEFAULT_MIN_INTERVAL_US = 20;
+
+private:
+  // Minimum time between edges considered real
+  uint32_t m_minInterval;
+
+  // Last A/B pin state
+  volatile uint8_t m_state;
+
+  // Accumulated count
+  volatile int32_t m_count;
+
+  // Time of the last edge
+  volatile uint32_t m_lastEdge;
+
+  // Time between the last two edges in the same direction
+  volatile uint32_t m_interval;
+
+  // Direction of the last edge
+  volatile int8_t m_direction;
+
+  // Edges that skipped a state (both pins changed)
+  volatile uint16_t m_errors;
+
+  // Reversals shorter than minimum interval (contact bounce)
+  volatile uint16_t m_glitches;
+
+public:
+  quadratureDecoder(uint32_t minIntervalUs = DEFAULT_MIN_INTERVAL_US);
+
+public:
+  // Set initial A/B pin state before enabling interrupts
+  void begin(bool a, bool b);
+
+  // Handle pin change, call from interrupt service routine
+  void edge(bool a, bool b, uint32_t now);
+
+  // Copy state, caller must disable interrupts around this call
+  void sample(quadratureSample& sample) const;
+
+  // Get number of edges that skipped a state
+  inline uint16_t getErrors() const
+  {
+    return m_errors;
+  }
+
+  // Get number of edges rejected as contact bounce
+  inline uint16_t getGlitches() const
+  {
+    return m_glitches;
+  }
+};
+
+} // namespace str1ker
@@ -0,0 +1,73 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ scheduler.cpp
+
+ Firmware Cooperative Scheduler Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include "scheduler.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| scheduler implementation
+\*----------------------------------------------------------*/
+
+scheduler::scheduler()
+  : m_count(0)
+  , m_missed(0)
+{
+}
+
+bool scheduler::add(uint32_t periodUs, taskCallback callback, void* context, uint32_t now)
+{
+  if (m_count == MAX_TASKS) return false;
+
+  task_t& task = m_tasks[m_count++];
+  task.period = periodUs;
+  task.next = now + periodUs;
+  task.callback = callback;
+  task.context = context;
+
+  return true;
+}
+
+void scheduler::run(uint32_t now)
+{
+  for (int n = 0; n < m_count; n++)
+  {
+    task_t& task = m_tasks[n];
+
+    if (!isDue(now, task.next)) continue;
+
+    task.callback(task.context, now);
+
+    // Keep a fixed cadence instead of drifting by loop latency
+    task.next += task.period;
+
+    if (isDue(now, task.next))
+    {
+      // Fell behind by a whole period, skip ahead instead of bursting
+      m_missed++;
+      task.next = now + task.period;
+    }
+  }
+}
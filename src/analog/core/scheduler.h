@@ -0,0 +1,94 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ scheduler.h
+
+ Firmware Cooperative Scheduler
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| Definitions
+\*----------------------------------------------------------*/
+
+typedef void (*taskCallback)(void* context, uint32_t now);
+
+/*----------------------------------------------------------*\
+| scheduler class
+\*----------------------------------------------------------*/
+
+class scheduler
+{
+private:
+  // Maximum number of periodic tasks
+  static const int MAX_TASKS = 4;
+
+  struct task_t
+  {
+    // Task period in microseconds
+    uint32_t period;
+
+    // Next deadline in microseconds
+    uint32_t next;
+
+    // Task handler
+    taskCallback callback;
+    void* context;
+  };
+
+private:
+  // Registered tasks
+  task_t m_tasks[MAX_TASKS];
+
+  // Number of registered tasks
+  int m_count;
+
+  // Number of deadlines missed by a whole period or more
+  uint32_t m_missed;
+
+public:
+  scheduler();
+
+public:
+  // Register periodic task, returns false if no slots left
+  bool add(uint32_t periodUs, taskCallback callback, void* context, uint32_t now);
+
+  // Run tasks that are due
+  void run(uint32_t now);
+
+  // Get number of missed deadlines
+  inline uint32_t getMissed() const
+  {
+    return m_missed;
+  }
+
+  // Determine if the deadline has been reached (wraparound-safe)
+  static inline bool isDue(uint32_t now, uint32_t deadline)
+  {
+    return int32_t(now - deadline) >= 0;
+  }
+};
+
+} // namespace str1ker
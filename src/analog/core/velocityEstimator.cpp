@@ -0,0 +1,80 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ velocityEstimator.cpp
+
+ Quadrature Velocity Estimator Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include "velocityEstimator.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| velocityEstimator implementation
+\*----------------------------------------------------------*/
+
+//
+// Constructor
+//
+
+velocityEstimator::velocityEstimator(int32_t fastCounts, uint32_t timeoutUs)
+  : m_fastCounts(fastCounts)
+  , m_timeout(timeoutUs)
+  , m_count(0)
+  , m_time(0)
+  , m_started(false)
+{
+}
+
+//
+// Estimation
+//
+
+float velocityEstimator::update(const quadratureSample& sample, uint32_t now)
+{
+  int32_t delta = sample.count - m_count;
+  uint32_t elapsed = now - m_time;
+  bool started = m_started;
+
+  m_count = sample.count;
+  m_time = now;
+  m_started = true;
+
+  if (!started || elapsed == 0) return 0.0f;
+
+  // Fast: count differencing over the frame
+  if (delta >= m_fastCounts || delta <= -m_fastCounts)
+    return float(delta) * 1000000.0f / float(elapsed);
+
+  // Stopped: no edges for too long
+  uint32_t sinceEdge = now - sample.lastEdge;
+
+  if (sample.direction == 0 || sinceEdge >= m_timeout) return 0.0f;
+
+  // Slow: period between edges, or no period yet after a reversal
+  if (sample.interval == 0)
+    return float(delta) * 1000000.0f / float(elapsed);
+
+  // Decay toward zero if the next edge is overdue
+  uint32_t period = sinceEdge > sample.interval ? sinceEdge : sample.interval;
+
+  return float(sample.direction) * 1000000.0f / float(period);
+}
@@ -0,0 +1,79 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ velocityEstimator.h
+
+ Quadrature Velocity Estimator
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdint.h>
+#include "quadratureDecoder.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| velocityEstimator class
+\*----------------------------------------------------------*/
+
+//
+// Estimates velocity once per frame. At low speeds few edges arrive
+// per frame so count differencing is coarse; the period between edges
+// (1/T) is used instead. At high speeds edge periods are short and
+// jittery, so the count difference over the frame is more accurate.
+//
+
+class velocityEstimator
+{
+private:
+  // Default count change per frame above which differencing is used
+  static const int32_t DEFAULT_FAST_COUNTS = 4;
+
+  // Default time without edges after which velocity is zero
+  static const uint32_t DEFAULT_TIMEOUT_US = 250000;
+
+private:
+  // Count change per frame above which differencing is used
+  int32_t m_fastCounts;
+
+  // Time without edges after which velocity is zero
+  uint32_t m_timeout;
+
+  // Previous frame count
+  int32_t m_count;
+
+  // Previous frame time
+  uint32_t m_time;
+
+  // Whether previous frame is available
+  bool m_started;
+
+public:
+  velocityEstimator(
+    int32_t fastCounts = DEFAULT_FAST_COUNTS,
+    uint32_t timeoutUs = DEFAULT_TIMEOUT_US);
+
+public:
+  // Estimate velocity in counts per second from latest sample
+  float update(const quadratureSample& sample, uint32_t now);
+};
+
+} // namespace str1ker
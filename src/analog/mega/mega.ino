@@ -19,27 +19,34 @@
 | Includes
 \*----------------------------------------------------------*/
 
-#define USE_USBCON
-
-#include <ros.h>                      // ROS communication
 #include <Adafruit_PWMServoDriver.h>  // Analog write library
-#include <str1ker/Adc.h>              // Analog read request
-#include <str1ker/Pwm.h>              // Analog write request
+#include <firmware.h>                 // Str1ker firmware core (src/analog/core)
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
 
 /*----------------------------------------------------------*\
 | Constants
 \*----------------------------------------------------------*/
 
-// ROS topics and spin rate
+// ROS topics, publish rate and output timeout
 const char ADC_TOPIC[] = "adc";
 const char PWM_TOPIC[] = "pwm";
-const double RATE_HZ = 50.0;
-const int DELAY = 1000.0 / RATE_HZ;
+const uint32_t RATE_HZ = 50;
+const uint32_t WATCHDOG_MS = 250;
+const long BAUD = 57600;
 
 // Analog output
 const int PWM_CHANNELS = 16;
 const int PWM_FREQ_HZ = 5000;
 const int PWM_MAX = 4096;
+const int PWM_PINS[] =
+{
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
 
 // Analog input
 const int ANALOG_CHANNELS = 12;
@@ -60,129 +67,124 @@ const int ANALOG_PINS[] =
 };
 
 /*----------------------------------------------------------*\
-| Declarations
+| arduinoHal class
 \*----------------------------------------------------------*/
 
-void writePwm(const str1ker::Pwm& msg);
+class arduinoHal : public hal
+{
+private:
+  // PCA9685 PWM driver
+  Adafruit_PWMServoDriver m_pwm = Adafruit_PWMServoDriver(
+    PCA9685_I2C_ADDRESS
+  );
 
-/*----------------------------------------------------------*\
-| Variables
-\*----------------------------------------------------------*/
+  // Whether PWM driver responded
+  bool m_pwmAvailable = false;
 
-// ADC publisher
-str1ker::Adc msg;
-uint16_t adc[ANALOG_CHANNELS] = {0};
-ros::Publisher pub(ADC_TOPIC, &msg);
+public:
+  void begin()
+  {
+    Serial.begin(BAUD);
 
-// PWM subscriber
-ros::Subscriber<str1ker::Pwm> sub(PWM_TOPIC, writePwm);
-Adafruit_PWMServoDriver pwm = Adafruit_PWMServoDriver(
-  PCA9685_I2C_ADDRESS
-);
+    for (int channel = 0; channel < ANALOG_CHANNELS; channel++)
+    {
+      pinMode(ANALOG_PINS[channel], INPUT_PULLUP);
+    }
 
-// ROS node
-ros::NodeHandle node;
+    Wire.begin();
+    Wire.beginTransmission(PCA9685_I2C_ADDRESS);
+    m_pwmAvailable = Wire.endTransmission() == 0;
 
-/*----------------------------------------------------------*\
-| Initialization
-\*----------------------------------------------------------*/
+    if (!m_pwmAvailable) return;
 
-void initAdc()
-{
-  for (int channel = 0; channel < ANALOG_CHANNELS; channel++)
+    m_pwm.begin();
+    m_pwm.setPWMFreq(PWM_FREQ_HZ);
+  }
+
+  virtual uint32_t micros()
   {
-    pinMode(ANALOG_PINS[channel], INPUT_PULLUP);
+    return ::micros();
   }
 
-  node.advertise(pub);
-}
+  virtual int16_t readAnalog(int pin)
+  {
+    return (int16_t)::analogRead(pin);
+  }
 
-bool isPwmAvailable()
-{
-  Wire.begin();
-  Wire.beginTransmission(PCA9685_I2C_ADDRESS);
-  return Wire.endTransmission() == 0;
-}
+  virtual void readQuadrature(int channel, quadratureSample& sample)
+  {
+    sample.count = 0;
+    sample.lastEdge = 0;
+    sample.interval = 0;
+    sample.direction = 0;
+  }
 
-void initPwm()
-{
-  if (!isPwmAvailable()) return;
- 
-  pwm.begin();
-  pwm.setPWMFreq(PWM_FREQ_HZ);
+  virtual void writeAnalog(int channel, uint16_t value)
+  {
+    if (!m_pwmAvailable) return;
 
-  node.subscribe(sub);
-}
+    // channel, when on (0-4096), when off (0-4096)
+    if (value == 0)
+      m_pwm.setPWM(channel, 0, PWM_MAX);
+    else if (value == PWM_MAX)
+      m_pwm.setPWM(channel, PWM_MAX, 0);
+    else
+      m_pwm.setPWM(channel, PWM_MAX - value, 0);
+  }
 
-void setup()
-{
-  node.initNode();
-  initAdc();
-  initPwm();
-}
+  virtual void writeDigital(int channel, bool value)
+  {
+    if (!m_pwmAvailable) return;
 
-/*----------------------------------------------------------*\
-| Analog input
-\*----------------------------------------------------------*/
+    if (value)
+      m_pwm.setPWM(channel, PWM_MAX, 0);
+    else
+      m_pwm.setPWM(channel, 0, PWM_MAX);
+  }
 
-void readAdc()
-{
-  for (int channel = 0; channel < ANALOG_CHANNELS; channel++)
+  virtual int receive()
   {
-    adc[channel] = (uint16_t)analogRead(ANALOG_PINS[channel]);
+    return Serial.read();
   }
 
-  msg.adc_length = ANALOG_CHANNELS;
-  msg.adc = adc;
-    
-  pub.publish(&msg);
-}
+  virtual void send(const uint8_t* data, int length)
+  {
+    Serial.write(data, length);
+  }
+};
 
 /*----------------------------------------------------------*\
-| Analog output
+| Variables
 \*----------------------------------------------------------*/
 
-void analog(int channel, int value)
-{
-  // channel, when on (0-4096), when off (0-4096)
-  if (value == 0)
-    pwm.setPWM(channel, 0, PWM_MAX);
-  else if (value == PWM_MAX)
-    pwm.setPWM(channel, PWM_MAX, 0);
-  else
-    pwm.setPWM(channel, PWM_MAX - value, 0);
-}
+// Hardware interface
+arduinoHal board;
 
-void digital(int channel, bool value)
+// Firmware configuration
+const firmwareConfig config =
 {
-  if (value)
-    pwm.setPWM(channel, PWM_MAX, 0);
-  else
-    pwm.setPWM(channel, 0, PWM_MAX);
-}
+  ADC_TOPIC,
+  PWM_TOPIC,
+  ANALOG_PINS,
+  ANALOG_CHANNELS,
+  PWM_PINS,
+  PWM_CHANNELS,
+  0,
+  RATE_HZ,
+  WATCHDOG_MS
+};
 
-void writePwm(const str1ker::Pwm& msg)
-{
-  for (uint32_t n = 0; n < msg.channels_length; n++)
-  {
-    str1ker::PwmChannel& request = msg.channels[n];
-    if (request.channel >= PWM_CHANNELS) continue;
+// Framing, scheduling and output logic
+firmware device(board, config);
 
-    if (request.mode == str1ker::PwmChannel::MODE_ANALOG)
-    {
-      analog(request.channel, request.value);
-    }
-    else
-    {
-      digital(request.channel, bool(request.value));
-    }
+/*----------------------------------------------------------*\
+| Initialization
+\*----------------------------------------------------------*/
 
-    if (request.duration > 0)
-    {
-      delay(request.duration);
-      digital(request.channel, request.value ? false : true);
-    }
-  }
+void setup()
+{
+  board.begin();
+  device.setup();
 }
 
 /*----------------------------------------------------------*\
@@ -191,7 +193,5 @@ void writePwm(const str1ker::Pwm& msg)
 
 void loop()
 {
-  readAdc();
-  node.spinOnce();
-  delay(DELAY);
+  device.loop();
 }
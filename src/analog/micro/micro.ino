@@ -19,12 +19,13 @@
 | Includes
 \*----------------------------------------------------------*/
 
-#define USE_USBCON
+#include <firmware.h>   // Str1ker firmware core (src/analog/core)
 
-#include <ros.h>                // ROS communication
-#include <str1ker/Adc.h>        // ADC/quadrature input request
-#include <str1ker/Pwm.h>        // PWM/digital output request
-#include <QuadratureEncoder.h>  // QuadratureEncoder library
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
 
 /*----------------------------------------------------------*\
 | Constants
@@ -36,8 +37,9 @@
 
 const char ADC_TOPIC[] = "adc";
 const char PWM_TOPIC[] = "pwm";
-const double RATE_HZ = 50.0;
-const int DELAY = 1000.0 / RATE_HZ;
+const uint32_t RATE_HZ = 50;
+const uint32_t WATCHDOG_MS = 250;
+const long BAUD = 57600;
 
 //
 // PWM outputs
@@ -79,157 +81,140 @@ const int ADC_PINS[] =
 const int QUADRATURE_CHANNELS = 1;
 const int QUADRATURE_PINS[][2] =
 {
-  { 2, 7 }
+  { 2, 7 }      // D2/INT1, D7/INT6
 };
 
 /*----------------------------------------------------------*\
-| Declarations
+| Variables
 \*----------------------------------------------------------*/
 
-void setup();
-void read();
-void write(const str1ker::Pwm& msg);
-void loop();
+// Quadrature decoders updated from pin change interrupts
+quadratureDecoder decoders[QUADRATURE_CHANNELS];
 
 /*----------------------------------------------------------*\
-| Variables
+| Interrupt handlers
 \*----------------------------------------------------------*/
 
-// Absolute and relative encoder readings
-int16_t readings[ADC_CHANNELS + QUADRATURE_CHANNELS] = {0};
-
-// Relative encoders
-Encoders** encoders;
-
-// ADC publisher
-str1ker::Adc msg;
-ros::Publisher pub(ADC_TOPIC, &msg);
-
-// PWM subscriber
-ros::Subscriber<str1ker::Pwm> sub(PWM_TOPIC, write);
+template<int channel>
+void quadratureEdge()
+{
+  decoders[channel].edge(
+    digitalRead(QUADRATURE_PINS[channel][0]),
+    digitalRead(QUADRATURE_PINS[channel][1]),
+    micros());
+}
 
-// ROS node
-ros::NodeHandle node;
+void (* const QUADRATURE_HANDLERS[])() =
+{
+  quadratureEdge<0>
+};
 
 /*----------------------------------------------------------*\
-| Initialization
+| arduinoHal class
 \*----------------------------------------------------------*/
 
-void initAdc()
+class arduinoHal : public hal
 {
-  for (int channel = 0; channel < ADC_CHANNELS; channel++)
+public:
+  void begin()
   {
-    pinMode(ADC_PINS[channel], INPUT_PULLUP);
-  }
+    Serial.begin(BAUD);
 
-  node.advertise(pub);
-}
+    for (int channel = 0; channel < ADC_CHANNELS; channel++)
+    {
+      pinMode(ADC_PINS[channel], INPUT_PULLUP);
+    }
 
-void initPwm()
-{
-  for (int channel = 0; channel < PWM_CHANNELS; channel++)
-  {
-    pinMode(PWM_PINS[channel], OUTPUT);
-  }
+    for (int channel = 0; channel < PWM_CHANNELS; channel++)
+    {
+      pinMode(PWM_PINS[channel], OUTPUT);
+    }
 
-  node.subscribe(sub);
-}
+    for (int channel = 0; channel < QUADRATURE_CHANNELS; channel++)
+    {
+      int a = QUADRATURE_PINS[channel][0];
+      int b = QUADRATURE_PINS[channel][1];
 
-void initQuadrature()
-{
-  encoders = new Encoders*[QUADRATURE_CHANNELS];
- 
-  for (int channel = 0; channel < QUADRATURE_CHANNELS; channel++)
+      pinMode(a, INPUT_PULLUP);
+      pinMode(b, INPUT_PULLUP);
+
+      decoders[channel].begin(digitalRead(a), digitalRead(b));
+
+      attachInterrupt(digitalPinToInterrupt(a), QUADRATURE_HANDLERS[channel], CHANGE);
+      attachInterrupt(digitalPinToInterrupt(b), QUADRATURE_HANDLERS[channel], CHANGE);
+    }
+  }
+
+  virtual uint32_t micros()
   {
-    encoders[channel] = new Encoders(
-      QUADRATURE_PINS[channel][0], QUADRATURE_PINS[channel][1]);
+    return ::micros();
+  }
 
-    readings[ADC_CHANNELS + channel] = 0;
+  virtual int16_t readAnalog(int pin)
+  {
+    return (int16_t)::analogRead(pin);
   }
-}
 
-void setup()
-{
-  // Initialize ROS interface
-  node.initNode();
-  node.negotiateTopics();
-
-  // Initialize inputs and outputs
-  initAdc();
-  initPwm();
-  initQuadrature();
-}
+  virtual void readQuadrature(int channel, quadratureSample& sample)
+  {
+    noInterrupts();
+    decoders[channel].sample(sample);
+    interrupts();
+  }
 
-/*----------------------------------------------------------*\
-| Absolute encoder input
-\*----------------------------------------------------------*/
+  virtual void writeAnalog(int pin, uint16_t value)
+  {
+    ::analogWrite(pin, value);
+  }
 
-void readAdc()
-{
-  for (int channel = 0; channel < ADC_CHANNELS; channel++)
+  virtual void writeDigital(int pin, bool value)
   {
-    readings[channel] = (int16_t)analogRead(ADC_PINS[channel]);
+    ::digitalWrite(pin, value ? HIGH : LOW);
   }
-}
 
-/*----------------------------------------------------------*\
-| Relative encoder input
-\*----------------------------------------------------------*/
+  virtual int receive()
+  {
+    return Serial.read();
+  }
 
-void readQuadrature()
-{
-  for (int channel = 0; channel < QUADRATURE_CHANNELS; channel++)
+  virtual void send(const uint8_t* data, int length)
   {
-    readings[ADC_CHANNELS + channel] = encoders[channel]->getEncoderCount();
+    Serial.write(data, length);
   }
-}
+};
 
 /*----------------------------------------------------------*\
-| Input
+| Firmware
 \*----------------------------------------------------------*/
 
-void read()
-{
-  readAdc();
-  readQuadrature();
+// Hardware interface
+arduinoHal board;
 
-  msg.adc_length = ADC_CHANNELS + QUADRATURE_CHANNELS;
-  msg.adc = readings;
+// Firmware configuration
+const firmwareConfig config =
+{
+  ADC_TOPIC,
+  PWM_TOPIC,
+  ADC_PINS,
+  ADC_CHANNELS,
+  PWM_PINS,
+  PWM_CHANNELS,
+  QUADRATURE_CHANNELS,
+  RATE_HZ,
+  WATCHDOG_MS
+};
 
-  pub.publish(&msg);
-}
+// Framing, scheduling and output logic
+firmware device(board, config);
 
 /*----------------------------------------------------------*\
-| Output
+| Initialization
 \*----------------------------------------------------------*/
 
-void write(const str1ker::Pwm& msg)
+void setup()
 {
-  for (int n = 0; n < msg.channels_length; n++)
-  {
-    str1ker::PwmChannel& request = msg.channels[n];
-
-    if (request.channel >= 0 && request.channel < PWM_CHANNELS)
-    {
-        if (request.mode == str1ker::PwmChannel::MODE_ANALOG)
-        {
-            // Write PWM waveform
-            analogWrite(PWM_PINS[request.channel], request.value);
-        }
-        else if (request.mode == str1ker::PwmChannel::MODE_DIGITAL)
-        {
-            // Write high or low
-            digitalWrite(PWM_PINS[request.channel], request.value ? HIGH : LOW);
-
-            if (request.duration > 0)
-            {
-                // Reset after waiting if duration specified
-                delay(request.duration);
-                digitalWrite(PWM_PINS[request.channel], LOW);
-            }
-        }
-    }
-  }
+  board.begin();
+  device.setup();
 }
 
 /*----------------------------------------------------------*\
@@ -238,7 +223,5 @@ void write(const str1ker::Pwm& msg)
 
 void loop()
 {
-  read();
-  node.spinOnce();
-  delay(DELAY);
+  device.loop();
 }
@@ -0,0 +1,189 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ analogSim.cpp
+
+ Analog Controller Simulator
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include "../core/firmware.h"
+#include "posixHal.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+// Simulated pins are channel numbers
+const int PINS[] =
+{
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
+
+// Arduino Micro: 8 analog inputs, 7 outputs, 1 quadrature encoder
+const firmwareConfig MICRO =
+{
+  "adc", "pwm", PINS, 8, PINS, 7, 1, 50, 250
+};
+
+// Arduino Mega: 12 analog inputs, 16 outputs
+const firmwareConfig MEGA =
+{
+  "adc", "pwm", PINS, 12, PINS, 16, 0, 50, 250
+};
+
+/*----------------------------------------------------------*\
+| Variables
+\*----------------------------------------------------------*/
+
+volatile sig_atomic_t running = 1;
+
+/*----------------------------------------------------------*\
+| Functions
+\*----------------------------------------------------------*/
+
+void usage()
+{
+  puts("usage: analog-sim [options]");
+  puts("  --board micro|mega          board to simulate (default micro)");
+  puts("  --rate <hz>                 readings publish rate (default 50)");
+  puts("  --watchdog <ms>             turn off outputs without requests (default 250, 0 disables)");
+  puts("  --adc <ch>:<offset>[:<amplitude>:<period>[:<noise>]]");
+  puts("                              simulate analog input as offset + sine + noise");
+  puts("  --quadrature <ch>:<rate>    simulate quadrature counts per second");
+  puts("  --link <path>               symlink pseudo-terminal at path");
+  puts("  --record <file.csv>         record outputs with timestamps");
+  puts("  --duration <sec>            exit after duration (default run until Ctrl+C)");
+}
+
+void stop(int)
+{
+  running = 0;
+}
+
+int main(int argc, char** argv)
+{
+  posixHal hardware;
+  firmwareConfig config = MICRO;
+  const char* linkPath = NULL;
+  const char* recordPath = NULL;
+  double duration = 0.0;
+
+  for (int arg = 1; arg < argc; arg++)
+  {
+    const char* value = arg + 1 < argc ? argv[arg + 1] : NULL;
+
+    if (!strcmp(argv[arg], "--board") && value)
+    {
+      config = strcmp(value, "mega") ? MICRO : MEGA;
+      arg++;
+    }
+    else if (!strcmp(argv[arg], "--rate") && value)
+    {
+      config.rateHz = uint32_t(atoi(value));
+      arg++;
+    }
+    else if (!strcmp(argv[arg], "--watchdog") && value)
+    {
+      config.watchdogMs = uint32_t(atoi(value));
+      arg++;
+    }
+    else if (!strcmp(argv[arg], "--adc") && value)
+    {
+      int channel = 0;
+      simulatedInput input = { 0.0, 0.0, 1.0, 0.0 };
+
+      sscanf(value, "%d:%lf:%lf:%lf:%lf",
+        &channel, &input.offset, &input.amplitude, &input.period, &input.noise);
+
+      hardware.setInput(channel, input);
+      arg++;
+    }
+    else if (!strcmp(argv[arg], "--quadrature") && value)
+    {
+      int channel = 0;
+      double rate = 0.0;
+
+      sscanf(value, "%d:%lf", &channel, &rate);
+
+      hardware.setQuadratureRate(channel, rate);
+      arg++;
+    }
+    else if (!strcmp(argv[arg], "--link") && value)
+    {
+      linkPath = value;
+      arg++;
+    }
+    else if (!strcmp(argv[arg], "--record") && value)
+    {
+      recordPath = value;
+      arg++;
+    }
+    else if (!strcmp(argv[arg], "--duration") && value)
+    {
+      duration = atof(value);
+      arg++;
+    }
+    else
+    {
+      usage();
+      return 1;
+    }
+  }
+
+  if (config.rateHz == 0)
+  {
+    usage();
+    return 1;
+  }
+
+  if (!hardware.open(linkPath)) return 1;
+  if (recordPath && !hardware.record(recordPath)) return 1;
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+
+  printf("simulating %d analog inputs and %d outputs at %u Hz\n",
+    config.adcChannels, config.pwmChannels, config.rateHz);
+  printf("connect with: rosrun rosserial_python serial_node.py %s\n",
+    hardware.getPath().c_str());
+
+  firmware device(hardware, config);
+  device.setup();
+
+  uint32_t end = uint32_t(duration * 1000000.0);
+
+  while (running && (!duration || hardware.micros() < end))
+  {
+    device.loop();
+    hardware.wait(1000);
+  }
+
+  hardware.report(stdout);
+
+  printf("watchdog timeouts: %u\n", device.getTimeouts());
+
+  return 0;
+}
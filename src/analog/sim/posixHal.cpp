@@ -0,0 +1,340 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ posixHal.cpp
+
+ Simulated Firmware Hardware on Linux Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include "../core/framing.h"
+#include "../core/messages.h"
+#include "posixHal.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| posixHal implementation
+\*----------------------------------------------------------*/
+
+//
+// Constructor
+//
+
+posixHal::posixHal()
+  : m_master(-1)
+  , m_record(NULL)
+  , m_start(now())
+  , m_seed(1)
+  , m_rxLength(0)
+  , m_rxPos(0)
+  , m_rxLast(0)
+  , m_telemetryTime(0)
+  , m_telemetryPending(false)
+  , m_framesSent(0)
+  , m_framesReceived(0)
+  , m_bytesSent(0)
+  , m_bytesReceived(0)
+  , m_outputs(0)
+  , m_latencySamples(0)
+  , m_latencySum(0)
+  , m_latencyMin(UINT32_MAX)
+  , m_latencyMax(0)
+{
+}
+
+posixHal::~posixHal()
+{
+  if (m_record) fclose(m_record);
+  if (m_master != -1) close(m_master);
+}
+
+//
+// Configuration
+//
+
+bool posixHal::open(const char* linkPath)
+{
+  m_master = posix_openpt(O_RDWR | O_NOCTTY);
+
+  if (m_master == -1 || grantpt(m_master) || unlockpt(m_master))
+  {
+    perror("failed to open pseudo-terminal");
+    return false;
+  }
+
+  // Raw mode so that framing bytes are not translated
+  struct termios settings;
+  tcgetattr(m_master, &settings);
+  cfmakeraw(&settings);
+  tcsetattr(m_master, TCSANOW, &settings);
+
+  fcntl(m_master, F_SETFL, fcntl(m_master, F_GETFL) | O_NONBLOCK);
+
+  m_slavePath = ptsname(m_master);
+
+  if (linkPath)
+  {
+    unlink(linkPath);
+
+    if (symlink(m_slavePath.c_str(), linkPath))
+    {
+      perror("failed to link pseudo-terminal");
+      return false;
+    }
+
+    m_slavePath = linkPath;
+  }
+
+  return true;
+}
+
+bool posixHal::record(const char* path)
+{
+  m_record = fopen(path, "w");
+
+  if (!m_record)
+  {
+    perror("failed to open output record");
+    return false;
+  }
+
+  fprintf(m_record, "time_us,mode,pin,value\n");
+
+  return true;
+}
+
+void posixHal::setInput(int pin, const simulatedInput& input)
+{
+  if (pin >= int(m_inputs.size()))
+  {
+    simulatedInput none = { 0.0, 0.0, 1.0, 0.0 };
+    m_inputs.resize(pin + 1, none);
+  }
+
+  m_inputs[pin] = input;
+}
+
+void posixHal::setQuadratureRate(int channel, double countsPerSecond)
+{
+  if (channel >= int(m_quadratureRates.size()))
+    m_quadratureRates.resize(channel + 1, 0.0);
+
+  m_quadratureRates[channel] = countsPerSecond;
+}
+
+void posixHal::wait(uint32_t timeoutUs)
+{
+  if (m_rxPos < m_rxLength) return;
+
+  struct pollfd fd;
+  fd.fd = m_master;
+  fd.events = POLLIN;
+
+  poll(&fd, 1, timeoutUs / 1000);
+}
+
+//
+// Time
+//
+
+uint64_t posixHal::now()
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+
+  return uint64_t(time.tv_sec) * 1000000ULL + uint64_t(time.tv_nsec) / 1000ULL;
+}
+
+uint32_t posixHal::micros()
+{
+  return uint32_t(now() - m_start);
+}
+
+//
+// Inputs
+//
+
+int16_t posixHal::readAnalog(int pin)
+{
+  if (pin < 0 || pin >= int(m_inputs.size())) return 0;
+
+  const simulatedInput& input = m_inputs[pin];
+  double seconds = double(micros()) / 1000000.0;
+
+  // Deterministic noise from a linear congruential generator
+  m_seed = m_seed * 1664525UL + 1013904223UL;
+  double noise = (double(m_seed >> 8) / double(1 << 24) * 2.0 - 1.0) * input.noise;
+
+  double reading = input.offset +
+    input.amplitude * sin(2.0 * M_PI * seconds / input.period) +
+    noise;
+
+  if (reading < 0.0) reading = 0.0;
+  if (reading > ANALOG_MAX) reading = ANALOG_MAX;
+
+  return int16_t(reading);
+}
+
+void posixHal::readQuadrature(int channel, quadratureSample& sample)
+{
+  sample.count = 0;
+  sample.lastEdge = 0;
+  sample.interval = 0;
+  sample.direction = 0;
+
+  if (channel < 0 || channel >= int(m_quadratureRates.size())) return;
+
+  double rate = m_quadratureRates[channel];
+  if (rate == 0.0) return;
+
+  // Edges arrive at a constant rate since startup
+  double seconds = double(micros()) / 1000000.0;
+  double count = trunc(rate * seconds);
+
+  sample.count = int32_t(count);
+  sample.lastEdge = uint32_t(count / rate * 1000000.0);
+  sample.interval = uint32_t(1000000.0 / fabs(rate));
+  sample.direction = rate > 0.0 ? 1 : -1;
+}
+
+//
+// Outputs
+//
+
+void posixHal::writeAnalog(int pin, uint16_t value)
+{
+  output("analog", pin, value);
+}
+
+void posixHal::writeDigital(int pin, bool value)
+{
+  output("digital", pin, value ? 1 : 0);
+}
+
+void posixHal::output(const char* mode, int pin, uint16_t value)
+{
+  uint32_t time = micros();
+
+  m_outputs++;
+
+  if (m_telemetryPending)
+  {
+    // Round trip from readings sent to first resulting output
+    uint32_t latency = time - m_telemetryTime;
+
+    m_latencySamples++;
+    m_latencySum += latency;
+    if (latency < m_latencyMin) m_latencyMin = latency;
+    if (latency > m_latencyMax) m_latencyMax = latency;
+
+    m_telemetryPending = false;
+  }
+
+  if (m_record)
+  {
+    fprintf(m_record, "%u,%s,%d,%u\n", time, mode, pin, value);
+  }
+}
+
+//
+// Serial
+//
+
+int posixHal::receive()
+{
+  if (m_rxPos == m_rxLength)
+  {
+    ssize_t received = read(m_master, m_rxBuffer, sizeof(m_rxBuffer));
+    if (received <= 0) return -1;
+
+    m_rxLength = int(received);
+    m_rxPos = 0;
+    m_bytesReceived += received;
+  }
+
+  uint8_t data = m_rxBuffer[m_rxPos++];
+
+  // Count frames by their protocol marker
+  if (m_rxLast == FRAME_SYNC && data == FRAME_PROTOCOL) m_framesReceived++;
+  m_rxLast = data;
+
+  return data;
+}
+
+void posixHal::send(const uint8_t* data, int length)
+{
+  int sent = 0;
+
+  while (sent < length)
+  {
+    ssize_t result = write(m_master, data + sent, length - sent);
+
+    if (result < 0)
+    {
+      // Host not connected or not reading, drop the frame
+      return;
+    }
+
+    sent += int(result);
+  }
+
+  m_framesSent++;
+  m_bytesSent += length;
+
+  uint16_t topic = uint16_t(data[5]) | (uint16_t(data[6]) << 8);
+
+  if (topic == TOPIC_ADC)
+  {
+    m_telemetryTime = micros();
+    m_telemetryPending = true;
+  }
+}
+
+//
+// Statistics
+//
+
+void posixHal::report(FILE* out)
+{
+  double seconds = double(micros()) / 1000000.0;
+
+  fprintf(out, "elapsed %.3f sec\n", seconds);
+  fprintf(out, "sent %u frames (%.1f/sec, %.1f bytes/sec)\n",
+    m_framesSent, m_framesSent / seconds, m_bytesSent / seconds);
+  fprintf(out, "received %u frames (%.1f/sec, %.1f bytes/sec)\n",
+    m_framesReceived, m_framesReceived / seconds, m_bytesReceived / seconds);
+  fprintf(out, "wrote %u outputs\n", m_outputs);
+
+  if (m_latencySamples)
+  {
+    fprintf(out, "readings to output latency: min %.3f avg %.3f max %.3f ms (%u samples)\n",
+      m_latencyMin / 1000.0,
+      double(m_latencySum) / double(m_latencySamples) / 1000.0,
+      m_latencyMax / 1000.0,
+      m_latencySamples);
+  }
+}
@@ -0,0 +1,169 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ posixHal.h
+
+ Simulated Firmware Hardware on Linux
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "../core/hal.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| simulatedInput struct
+\*----------------------------------------------------------*/
+
+struct simulatedInput
+{
+  // Reading at rest
+  double offset;
+
+  // Sine wave amplitude
+  double amplitude;
+
+  // Sine wave period in seconds
+  double period;
+
+  // Uniform noise amplitude
+  double noise;
+};
+
+/*----------------------------------------------------------*\
+| posixHal class
+\*----------------------------------------------------------*/
+
+class posixHal : public hal
+{
+private:
+  // Analog input range
+  const int ANALOG_MAX = 1023;
+
+private:
+  //
+  // Configuration
+  //
+
+  // Pseudo-terminal master
+  int m_master;
+
+  // Pseudo-terminal slave path that the host connects to
+  std::string m_slavePath;
+
+  // Simulated analog inputs by pin
+  std::vector<simulatedInput> m_inputs;
+
+  // Simulated quadrature rate in counts per second
+  std::vector<double> m_quadratureRates;
+
+  // Output log
+  FILE* m_record;
+
+  //
+  // State
+  //
+
+  // Start time
+  uint64_t m_start;
+
+  // Noise generator state
+  uint32_t m_seed;
+
+  // Receive buffer
+  uint8_t m_rxBuffer[256];
+  int m_rxLength;
+  int m_rxPos;
+  uint8_t m_rxLast;
+
+  // Time last readings frame was sent
+  uint32_t m_telemetryTime;
+  bool m_telemetryPending;
+
+  //
+  // Statistics
+  //
+
+  uint32_t m_framesSent;
+  uint32_t m_framesReceived;
+  uint64_t m_bytesSent;
+  uint64_t m_bytesReceived;
+  uint32_t m_outputs;
+  uint32_t m_latencySamples;
+  uint64_t m_latencySum;
+  uint32_t m_latencyMin;
+  uint32_t m_latencyMax;
+
+public:
+  posixHal();
+  ~posixHal();
+
+public:
+  // Open pseudo-terminal and optionally link it at a stable path
+  bool open(const char* linkPath);
+
+  // Record outputs with timestamps to a CSV file
+  bool record(const char* path);
+
+  // Configure simulated analog input pin
+  void setInput(int pin, const simulatedInput& input);
+
+  // Configure simulated quadrature encoder rate
+  void setQuadratureRate(int channel, double countsPerSecond);
+
+  // Wait for serial data or timeout
+  void wait(uint32_t timeoutUs);
+
+  // Get the path the host should connect to
+  inline const std::string& getPath() const
+  {
+    return m_slavePath;
+  }
+
+  // Print latency and throughput statistics
+  void report(FILE* out);
+
+public:
+  //
+  // Hardware interface
+  //
+
+  virtual uint32_t micros();
+  virtual int16_t readAnalog(int pin);
+  virtual void readQuadrature(int channel, quadratureSample& sample);
+  virtual void writeAnalog(int pin, uint16_t value);
+  virtual void writeDigital(int pin, bool value);
+  virtual int receive();
+  virtual void send(const uint8_t* data, int length);
+
+private:
+  // Log an output change and measure latency from last readings
+  void output(const char* mode, int pin, uint16_t value);
+
+  // Get monotonic time in microseconds
+  static uint64_t now();
+};
+
+} // namespace str1ker
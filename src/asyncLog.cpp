@@ -0,0 +1,448 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ asyncLog.cpp
+
+ Asynchronous Lock-Free Logging Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include "asyncLog.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+// How long the background thread sleeps when there is nothing to output
+const chrono::milliseconds IDLE_SLEEP(1);
+
+// Output delay worth reporting along with the message
+const int64_t LATE_NS = 1000000;
+
+// Maximum formatted message length
+const size_t TEXT_SIZE = 1024;
+
+/*----------------------------------------------------------*\
+| Helpers
+\*----------------------------------------------------------*/
+
+static inline int64_t steadyNow()
+{
+  return chrono::duration_cast<chrono::nanoseconds>(
+    chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*----------------------------------------------------------*\
+| asyncLogThrottle implementation
+\*----------------------------------------------------------*/
+
+asyncLogThrottle::asyncLogThrottle()
+  : m_next(0)
+{
+}
+
+bool asyncLogThrottle::allow(double periodSec)
+{
+  int64_t now = steadyNow();
+  int64_t next = m_next.load(memory_order_relaxed);
+
+  if (now < next) return false;
+
+  // Only one thread wins the slot if several race here
+  return m_next.compare_exchange_strong(
+    next, now + int64_t(periodSec * 1e9), memory_order_relaxed);
+}
+
+/*----------------------------------------------------------*\
+| asyncLog implementation
+\*----------------------------------------------------------*/
+
+//
+// Lifetime
+//
+
+asyncLog::asyncLog()
+  : m_enqueue(0)
+  , m_dequeue(0)
+  , m_dropped(0)
+  , m_stop(false)
+{
+  for (size_t index = 0; index < CAPACITY; index++)
+    m_records[index].sequence.store(index, memory_order_relaxed);
+
+  m_thread = thread(&asyncLog::run, this);
+}
+
+asyncLog::~asyncLog()
+{
+  m_stop = true;
+
+  if (m_thread.joinable()) m_thread.join();
+}
+
+asyncLog& asyncLog::instance()
+{
+  static asyncLog log;
+  return log;
+}
+
+uint64_t asyncLog::getDropped()
+{
+  return instance().m_dropped.load(memory_order_relaxed);
+}
+
+void asyncLog::flush()
+{
+  asyncLog& log = instance();
+  size_t target = log.m_enqueue.load(memory_order_acquire);
+
+  while (log.m_dequeue.load(memory_order_acquire) < target)
+    this_thread::sleep_for(IDLE_SLEEP);
+}
+
+//
+// Bounded multi-producer ring (Vyukov)
+//
+
+asyncLog::record_t* asyncLog::claim()
+{
+  size_t pos = m_enqueue.load(memory_order_relaxed);
+
+  while (true)
+  {
+    record_t* rec = &m_records[pos & (CAPACITY - 1)];
+    size_t sequence = rec->sequence.load(memory_order_acquire);
+    intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+
+    if (diff == 0)
+    {
+      if (m_enqueue.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+      {
+        rec->time = steadyNow();
+        return rec;
+      }
+    }
+    else if (diff < 0)
+    {
+      // Full: drop rather than block the caller
+      m_dropped.fetch_add(1, memory_order_relaxed);
+      return NULL;
+    }
+    else
+    {
+      pos = m_enqueue.load(memory_order_relaxed);
+    }
+  }
+}
+
+void asyncLog::publish(record_t* rec)
+{
+  size_t pos = rec->sequence.load(memory_order_relaxed);
+  rec->sequence.store(pos + 1, memory_order_release);
+}
+
+//
+// Background output
+//
+
+void asyncLog::run()
+{
+  uint64_t reported = 0;
+
+  while (!m_stop)
+  {
+    if (!drain()) this_thread::sleep_for(IDLE_SLEEP);
+
+    uint64_t dropped = m_dropped.load(memory_order_relaxed);
+
+    if (dropped != reported)
+    {
+      ROS_WARN("async log dropped %llu records, ring full", (unsigned long long)(dropped - reported));
+      reported = dropped;
+    }
+  }
+
+  drain();
+}
+
+size_t asyncLog::drain()
+{
+  char text[TEXT_SIZE];
+  size_t count = 0;
+
+  while (true)
+  {
+    size_t pos = m_dequeue.load(memory_order_relaxed);
+    record_t& rec = m_records[pos & (CAPACITY - 1)];
+
+    if (rec.sequence.load(memory_order_acquire) != pos + 1)
+      break;
+
+    format(rec, text, sizeof(text));
+
+    int64_t late = steadyNow() - rec.time;
+
+    if (late > LATE_NS)
+    {
+      size_t length = strlen(text);
+      snprintf(text + length, sizeof(text) - length, " (+%.1f ms)", double(late) / 1e6);
+    }
+
+    ros::console::print(
+      NULL, rec.logger, rec.level, rec.file, rec.line, rec.function, "%s", text);
+
+    // Release record to producers
+    rec.sequence.store(pos + CAPACITY, memory_order_release);
+    m_dequeue.store(pos + 1, memory_order_release);
+    count++;
+  }
+
+  return count;
+}
+
+//
+// Formatting
+//
+
+void asyncLog::format(const record_t& rec, char* text, size_t size)
+{
+  const char* pos = rec.format;
+  const uint8_t* arg = rec.payload;
+  const uint8_t* argEnd = rec.payload + rec.length;
+  size_t length = 0;
+
+  text[0] = '\0';
+
+  while (*pos && length + 1 < size)
+  {
+    if (*pos != '%')
+    {
+      text[length++] = *pos++;
+      text[length] = '\0';
+      continue;
+    }
+
+    if (pos[1] == '%')
+    {
+      text[length++] = '%';
+      text[length] = '\0';
+      pos += 2;
+      continue;
+    }
+
+    // Copy flags, width and precision, drop length modifiers
+    char spec[32] = "%";
+    size_t specLength = 1;
+    const char* start = pos++;
+
+    while (*pos && strchr("-+ #0123456789.", *pos) && specLength < sizeof(spec) - 4)
+      spec[specLength++] = *pos++;
+
+    while (*pos && strchr("hlLqjzt", *pos))
+      pos++;
+
+    char conversion = *pos ? *pos++ : 's';
+
+    if (arg >= argEnd)
+    {
+      // Missing argument: output specifier as is
+      int written = snprintf(text + length, size - length, "%.*s", int(pos - start), start);
+      if (written > 0) length = min(length + size_t(written), size - 1);
+      continue;
+    }
+
+    argType type = argType(*arg++);
+    int written = 0;
+
+    if (type == STRING)
+    {
+      uint8_t stringLength = *arg++;
+      char value[MAX_STRING + 1];
+
+      memcpy(value, arg, stringLength);
+      value[stringLength] = '\0';
+      arg += stringLength;
+
+      spec[specLength++] = 's';
+      spec[specLength] = '\0';
+      written = snprintf(text + length, size - length, spec, value);
+    }
+    else
+    {
+      union
+      {
+        long long i;
+        unsigned long long u;
+        double d;
+        const void* p;
+      } value;
+
+      memcpy(&value, arg, sizeof(value));
+      arg += sizeof(value);
+
+      if (strchr("eEfFgGaA", conversion))
+      {
+        double real = type == REAL ? value.d : type == SIGNED ? double(value.i) : double(value.u);
+
+        spec[specLength++] = conversion;
+        spec[specLength] = '\0';
+        written = snprintf(text + length, size - length, spec, real);
+      }
+      else if (strchr("di", conversion))
+      {
+        long long integer = type == REAL ? (long long)value.d : value.i;
+
+        spec[specLength++] = 'l';
+        spec[specLength++] = 'l';
+        spec[specLength++] = 'd';
+        spec[specLength] = '\0';
+        written = snprintf(text + length, size - length, spec, integer);
+      }
+      else if (strchr("uoxX", conversion))
+      {
+        unsigned long long integer = type == REAL ? (unsigned long long)value.d : value.u;
+
+        spec[specLength++] = 'l';
+        spec[specLength++] = 'l';
+        spec[specLength++] = conversion;
+        spec[specLength] = '\0';
+        written = snprintf(text + length, size - length, spec, integer);
+      }
+      else if (conversion == 'c')
+      {
+        spec[specLength++] = 'c';
+        spec[specLength] = '\0';
+        written = snprintf(text + length, size - length, spec, int(value.i));
+      }
+      else
+      {
+        spec[specLength++] = 'p';
+        spec[specLength] = '\0';
+        written = snprintf(text + length, size - length, spec, value.p);
+      }
+    }
+
+    // Clamp to buffer so truncated output stops further appends
+    if (written > 0) length = min(length + size_t(written), size - 1);
+  }
+}
+
+//
+// Argument encoding
+//
+
+void asyncLog::encoder_t::put(argType type, const void* value, size_t size)
+{
+  // Values are stored in a fixed-size slot to keep decoding simple
+  const size_t SLOT = sizeof(long long) > sizeof(double) ? sizeof(long long) : sizeof(double);
+
+  if (rec->length + 1 + SLOT > PAYLOAD_SIZE) return;
+
+  uint8_t* pos = rec->payload + rec->length;
+  *pos++ = type;
+  memset(pos, 0, SLOT);
+  memcpy(pos, value, size);
+  rec->length += 1 + SLOT;
+}
+
+void asyncLog::encoder_t::put(const char* value, size_t length)
+{
+  if (length > MAX_STRING) length = MAX_STRING;
+  if (rec->length + 2 + length > PAYLOAD_SIZE) return;
+
+  uint8_t* pos = rec->payload + rec->length;
+  *pos++ = STRING;
+  *pos++ = uint8_t(length);
+  memcpy(pos, value, length);
+  rec->length += 2 + length;
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, bool value)
+{
+  long long integer = value;
+  encoder.put(SIGNED, &integer, sizeof(integer));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, char value)
+{
+  long long integer = value;
+  encoder.put(SIGNED, &integer, sizeof(integer));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, int value)
+{
+  long long integer = value;
+  encoder.put(SIGNED, &integer, sizeof(integer));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, long value)
+{
+  long long integer = value;
+  encoder.put(SIGNED, &integer, sizeof(integer));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, long long value)
+{
+  encoder.put(SIGNED, &value, sizeof(value));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, unsigned int value)
+{
+  unsigned long long integer = value;
+  encoder.put(UNSIGNED, &integer, sizeof(integer));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, unsigned long value)
+{
+  unsigned long long integer = value;
+  encoder.put(UNSIGNED, &integer, sizeof(integer));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, unsigned long long value)
+{
+  encoder.put(UNSIGNED, &value, sizeof(value));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, double value)
+{
+  encoder.put(REAL, &value, sizeof(value));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, const char* value)
+{
+  if (!value) value = "(null)";
+  encoder.put(value, strlen(value));
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, const string& value)
+{
+  encoder.put(value.c_str(), value.length());
+}
+
+void asyncLog::encodeValue(encoder_t& encoder, const void* value)
+{
+  encoder.put(POINTER, &value, sizeof(value));
+}
@@ -0,0 +1,267 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ asyncLog.h
+
+ Asynchronous Lock-Free Logging
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <stdint.h>
+#include <ros/console.h>
+
+/*----------------------------------------------------------*\
+| Macros
+\*----------------------------------------------------------*/
+
+//
+// Drop-in replacements for ROS_*_NAMED that only capture arguments on the
+// calling thread. Formatting and output happen on a background thread.
+// Level checks use the same per-call-site location as rosconsole.
+//
+
+#define ASYNC_LOG_COND(cond, level, name, ...) \
+  do \
+  { \
+    ROSCONSOLE_DEFINE_LOCATION(cond, level, name); \
+    if (ROS_UNLIKELY(__rosconsole_define_location__enabled)) \
+    { \
+      ::str1ker::asyncLog::write( \
+        __rosconsole_define_location__loc.logger_, \
+        __rosconsole_define_location__loc.level_, \
+        __FILE__, __LINE__, __ROSCONSOLE_FUNCTION__, __VA_ARGS__); \
+    } \
+  } while (false)
+
+#define ASYNC_LOG_THROTTLE(period, level, name, ...) \
+  do \
+  { \
+    static ::str1ker::asyncLogThrottle __async_log_throttle__; \
+    ASYNC_LOG_COND(__async_log_throttle__.allow(period), level, name, __VA_ARGS__); \
+  } while (false)
+
+#define ASYNC_LOG_NAME(name) std::string(ROSCONSOLE_NAME_PREFIX) + "." + (name)
+
+#define ASYNC_DEBUG(...) ASYNC_LOG_COND(true, ::ros::console::levels::Debug, ROSCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define ASYNC_INFO(...) ASYNC_LOG_COND(true, ::ros::console::levels::Info, ROSCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define ASYNC_WARN(...) ASYNC_LOG_COND(true, ::ros::console::levels::Warn, ROSCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+#define ASYNC_ERROR(...) ASYNC_LOG_COND(true, ::ros::console::levels::Error, ROSCONSOLE_DEFAULT_NAME, __VA_ARGS__)
+
+#define ASYNC_DEBUG_NAMED(name, ...) ASYNC_LOG_COND(true, ::ros::console::levels::Debug, ASYNC_LOG_NAME(name), __VA_ARGS__)
+#define ASYNC_INFO_NAMED(name, ...) ASYNC_LOG_COND(true, ::ros::console::levels::Info, ASYNC_LOG_NAME(name), __VA_ARGS__)
+#define ASYNC_WARN_NAMED(name, ...) ASYNC_LOG_COND(true, ::ros::console::levels::Warn, ASYNC_LOG_NAME(name), __VA_ARGS__)
+#define ASYNC_ERROR_NAMED(name, ...) ASYNC_LOG_COND(true, ::ros::console::levels::Error, ASYNC_LOG_NAME(name), __VA_ARGS__)
+
+#define ASYNC_DEBUG_THROTTLE_NAMED(period, name, ...) ASYNC_LOG_THROTTLE(period, ::ros::console::levels::Debug, ASYNC_LOG_NAME(name), __VA_ARGS__)
+#define ASYNC_INFO_THROTTLE_NAMED(period, name, ...) ASYNC_LOG_THROTTLE(period, ::ros::console::levels::Info, ASYNC_LOG_NAME(name), __VA_ARGS__)
+#define ASYNC_WARN_THROTTLE_NAMED(period, name, ...) ASYNC_LOG_THROTTLE(period, ::ros::console::levels::Warn, ASYNC_LOG_NAME(name), __VA_ARGS__)
+#define ASYNC_ERROR_THROTTLE_NAMED(period, name, ...) ASYNC_LOG_THROTTLE(period, ::ros::console::levels::Error, ASYNC_LOG_NAME(name), __VA_ARGS__)
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| asyncLogThrottle class
+\*----------------------------------------------------------*/
+
+class asyncLogThrottle
+{
+private:
+  // Earliest time the call site may log again in nanoseconds
+  std::atomic<int64_t> m_next;
+
+public:
+  asyncLogThrottle();
+
+public:
+  // Determine if the call site may log now, at most once per period
+  bool allow(double periodSec);
+};
+
+/*----------------------------------------------------------*\
+| asyncLog class
+\*----------------------------------------------------------*/
+
+class asyncLog
+{
+public:
+  // Number of records in the ring, must be a power of two
+  static const size_t CAPACITY = 1024;
+
+  // Maximum bytes of captured arguments per record
+  static const size_t PAYLOAD_SIZE = 256;
+
+  // Maximum characters captured per string argument
+  static const size_t MAX_STRING = 64;
+
+private:
+  // Argument tags in the binary record
+  enum argType : uint8_t
+  {
+    SIGNED,
+    UNSIGNED,
+    REAL,
+    STRING,
+    POINTER
+  };
+
+  // Binary log record, formatted later by background thread
+  struct record_t
+  {
+    // Ring sequence number for lock-free handoff
+    std::atomic<size_t> sequence;
+
+    // Capture time in steady clock nanoseconds
+    int64_t time;
+
+    // Rosconsole logger and level resolved at call site
+    void* logger;
+    ros::console::Level level;
+
+    // Call site, all static strings
+    const char* file;
+    int line;
+    const char* function;
+    const char* format;
+
+    // Captured arguments: tag followed by value
+    size_t length;
+    uint8_t payload[PAYLOAD_SIZE];
+  };
+
+  // Argument encoder over a record payload
+  struct encoder_t
+  {
+    record_t* rec;
+
+    void put(argType type, const void* value, size_t size);
+    void put(const char* value, size_t length);
+  };
+
+private:
+  // Preallocated record ring
+  record_t m_records[CAPACITY];
+
+  // Next record to claim by producers
+  std::atomic<size_t> m_enqueue;
+
+  // Next record to format, written by background thread only
+  std::atomic<size_t> m_dequeue;
+
+  // Records dropped because the ring was full
+  std::atomic<uint64_t> m_dropped;
+
+  // Background thread
+  std::thread m_thread;
+
+  // Stop request for background thread
+  std::atomic<bool> m_stop;
+
+public:
+  // Capture log record without blocking or allocating
+  template<typename... Args> static void write(
+    void* logger,
+    ros::console::Level level,
+    const char* file,
+    int line,
+    const char* function,
+    const char* format,
+    const Args&... args)
+  {
+    asyncLog& log = instance();
+    record_t* rec = log.claim();
+
+    if (!rec) return;
+
+    rec->logger = logger;
+    rec->level = level;
+    rec->file = file;
+    rec->line = line;
+    rec->function = function;
+    rec->format = format;
+    rec->length = 0;
+
+    encoder_t encoder = { rec };
+    encode(encoder, args...);
+
+    log.publish(rec);
+  }
+
+  // Get number of records dropped because the ring was full
+  static uint64_t getDropped();
+
+  // Wait until all captured records are output
+  static void flush();
+
+private:
+  asyncLog();
+  ~asyncLog();
+
+  // Get the process-wide log
+  static asyncLog& instance();
+
+  // Claim next free record, or NULL if full
+  record_t* claim();
+
+  // Hand claimed record to background thread
+  void publish(record_t* rec);
+
+  // Format and output records until stopped
+  void run();
+
+  // Format and output available records, returns number output
+  size_t drain();
+
+  // Format record arguments into text
+  static void format(const record_t& rec, char* text, size_t size);
+
+  //
+  // Argument encoding
+  //
+
+  static inline void encode(encoder_t&)
+  {
+  }
+
+  template<typename T, typename... Args> static void encode(
+    encoder_t& encoder, const T& value, const Args&... args)
+  {
+    encodeValue(encoder, value);
+    encode(encoder, args...);
+  }
+
+  static void encodeValue(encoder_t& encoder, bool value);
+  static void encodeValue(encoder_t& encoder, char value);
+  static void encodeValue(encoder_t& encoder, int value);
+  static void encodeValue(encoder_t& encoder, long value);
+  static void encodeValue(encoder_t& encoder, long long value);
+  static void encodeValue(encoder_t& encoder, unsigned int value);
+  static void encodeValue(encoder_t& encoder, unsigned long value);
+  static void encodeValue(encoder_t& encoder, unsigned long long value);
+  static void encodeValue(encoder_t& encoder, double value);
+  static void encodeValue(encoder_t& encoder, const char* value);
+  static void encodeValue(encoder_t& encoder, const std::string& value);
+  static void encodeValue(encoder_t& encoder, const void* value);
+};
+
+} // namespace str1ker
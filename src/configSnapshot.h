@@ -0,0 +1,118 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ configSnapshot.h
+
+ Lock-Free Configuration Snapshot
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <atomic>
+#include <utility>
+#include <stdint.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| configSnapshot class
+\*----------------------------------------------------------*/
+
+//
+// Triple buffer for handing settings from a reload thread to the
+// update loop. The writer fills the back buffer and swaps it with the
+// middle one; the reader swaps the middle one with the front buffer
+// only when it was updated. Neither side ever waits on the other.
+// Single writer, single reader, T should be plain data unless handed
+// over with exchange and take, which swap instead of copying so
+// buffers holding containers are recycled without allocating.
+//
+
+template<class T> class configSnapshot
+{
+private:
+  // Middle buffer index mask
+  static const uint8_t INDEX = 0x3;
+
+  // Middle buffer contains a snapshot the reader has not seen
+  static const uint8_t DIRTY = 0x4;
+
+private:
+  // Front, middle and back buffers
+  T m_buffers[3];
+
+  // Middle buffer index and dirty flag, shared by both sides
+  std::atomic<uint8_t> m_middle;
+
+  // Back buffer index, owned by writer
+  uint8_t m_back;
+
+  // Front buffer index, owned by reader
+  uint8_t m_front;
+
+public:
+  configSnapshot()
+    : m_middle(1)
+    , m_back(2)
+    , m_front(0)
+  {
+  }
+
+public:
+  // Publish new snapshot, call from writer thread
+  void publish(const T& value)
+  {
+    m_buffers[m_back] = value;
+    m_back = m_middle.exchange(m_back | DIRTY, std::memory_order_acq_rel) & INDEX;
+  }
+
+  // Take latest snapshot if there is a new one, call from reader thread
+  bool consume(T& value)
+  {
+    if (!(m_middle.load(std::memory_order_acquire) & DIRTY))
+      return false;
+
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+    value = m_buffers[m_front];
+
+    return true;
+  }
+
+  // Publish new snapshot by swapping, value receives a recycled buffer, call from writer thread
+  void exchange(T& value)
+  {
+    std::swap(m_buffers[m_back], value);
+    m_back = m_middle.exchange(m_back | DIRTY, std::memory_order_acq_rel) & INDEX;
+  }
+
+  // Take latest snapshot by swapping if there is a new one, call from reader thread
+  bool take(T& value)
+  {
+    if (!(m_middle.load(std::memory_order_acquire) & DIRTY))
+      return false;
+
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+    std::swap(m_buffers[m_front], value);
+
+    return true;
+  }
+};
+
+} // namespace str1ker
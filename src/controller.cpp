@@ -79,11 +79,16 @@ const bool controller::isEnabled()
     return m_enable;
 }
 
+void controller::setSettings(const XmlRpc::XmlRpcValue& settings)
+{
+    m_settings = settings;
+}
+
 bool controller::configure()
 {
     ROS_INFO("  loading %s %s", getType().c_str(), getPath().c_str());
 
-    ros::param::get(getChildPath("enable"), m_enable);
+    getSetting("enable", m_enable);
 
     return true;
 }
@@ -97,7 +102,49 @@ void controller::update(ros::Time time, ros::Duration period)
 {
 }
 
+bool controller::stage(XmlRpc::XmlRpcValue& settings)
+{
+    return true;
+}
+
+void controller::release()
+{
+}
+
+bool controller::commit()
+{
+    return false;
+}
+
 string controller::getChildPath(const string& controllerName)
 {
     return m_path + "/" + controllerName;
 }
+
+bool controller::getSetting(const string& name, bool& value)
+{
+    return getSettingValue(name, value);
+}
+
+bool controller::getSetting(const string& name, int& value)
+{
+    return getSettingValue(name, value);
+}
+
+bool controller::getSetting(const string& name, double& value)
+{
+    return getSettingValue(name, value);
+}
+
+bool controller::getSetting(const string& name, string& value)
+{
+    return getSettingValue(name, value);
+}
+
+template<class T> bool controller::getSettingValue(const string& name, T& value)
+{
+    if (m_settings.valid())
+        return controllerUtilities::getSetting(m_settings, name, value);
+
+    return ros::param::get(getChildPath(name), value);
+}
@@ -22,6 +22,7 @@
 \*----------------------------------------------------------*/
 
 #include <ros/ros.h>
+#include <xmlrpcpp/XmlRpcValue.h>
 #include <string>
 
 /*----------------------------------------------------------*\
@@ -58,6 +59,9 @@ protected:
     // Whether controller is enabled
     bool m_enable;
 
+    // Controller settings subtree, fetched once by the factory
+    XmlRpc::XmlRpcValue m_settings;
+
 public:
     controller(ros::NodeHandle node, std::string type, std::string path);
 
@@ -83,6 +87,9 @@ public:
     // Get enabled status
     const bool isEnabled();
 
+    // Assign settings subtree to configure from
+    void setSettings(const XmlRpc::XmlRpcValue& settings);
+
     // Load controller settings
     virtual bool configure();
 
@@ -92,9 +99,27 @@ public:
     // Update self and/or children
     virtual void update(ros::Time time, ros::Duration period);
 
+    // Validate reloaded settings and keep them staged, call from reload thread
+    virtual bool stage(XmlRpc::XmlRpcValue& settings);
+
+    // Hand staged settings over without blocking, call from reload thread
+    virtual void release();
+
+    // Apply released settings at a cycle boundary, returns true if changed
+    virtual bool commit();
+
 protected:
     // Get child controller path
     std::string getChildPath(const std::string& controllerName);
+
+    // Get setting from settings subtree, or parameter server if not assigned
+    bool getSetting(const std::string& name, bool& value);
+    bool getSetting(const std::string& name, int& value);
+    bool getSetting(const std::string& name, double& value);
+    bool getSetting(const std::string& name, std::string& value);
+
+private:
+    template<class T> bool getSettingValue(const std::string& name, T& value);
 };
 
 } // namespace str1ker
@@ -49,6 +49,16 @@ controllerFactory::controllerFactory()
 }
 
 controller* controllerFactory::fromPath(ros::NodeHandle node, string path)
+{
+    XmlRpc::XmlRpcValue settings;
+
+    if (!ros::param::get(path, settings))
+        return NULL;
+
+    return fromSettings(node, path, settings);
+}
+
+controller* controllerFactory::fromSettings(ros::NodeHandle node, string path, XmlRpc::XmlRpcValue& settings)
 {
     try
     {
@@ -60,7 +70,7 @@ controller* controllerFactory::fromPath(ros::NodeHandle node, string path)
 
         string controllerType;
 
-        if (!ros::param::get(path + "/controller", controllerType))
+        if (!controllerUtilities::getSetting(settings, "controller", controllerType))
             return NULL;
 
         if (s_types.find(controllerType) == s_types.end())
@@ -77,7 +87,7 @@ controller* controllerFactory::fromPath(ros::NodeHandle node, string path)
             if (NULL == reg.instance)
             {
                 reg.instance = reg.create(node, path);
-                reg.instance->configure();
+                reg.instance->setSettings(settings);
             }
 
             instance = reg.instance;
@@ -85,7 +95,7 @@ controller* controllerFactory::fromPath(ros::NodeHandle node, string path)
         else
         {
             instance = reg.create(node, path);
-            instance->configure();
+            instance->setSettings(settings);
         }
 
         return instance;
@@ -131,35 +141,48 @@ controller* controllerFactory::fromType(string type)
 
 controllerArray controllerFactory::fromNamespace(ros::NodeHandle node, string controllerNamespace)
 {
-    vector<string> params;
-    ros::param::getParamNames(params);
+    XmlRpc::XmlRpcValue settings;
 
+    if (!ros::param::get(controllerNamespace, settings))
+        return controllerArray();
+
+    return fromNamespace(node, controllerNamespace, settings);
+}
+
+controllerArray controllerFactory::fromNamespace(ros::NodeHandle node, string controllerNamespace, XmlRpc::XmlRpcValue& settings)
+{
     controllerArray controllers;
-    set<string> controllerPaths;
 
     string parentPath = controllerNamespace[0] == '/'
-        ? controllerNamespace.c_str() + 1
-        : controllerNamespace.c_str();
+        ? controllerNamespace
+        : "/" + controllerNamespace;
 
-    for (vector<string>::iterator pos = params.begin();
-        pos != params.end();
-        pos++)
-    {
-        auto path = controllerUtilities::getControllerPath(*pos, parentPath);
+    findControllers(node, parentPath, settings, controllers);
 
-        if (path.length() && controllerPaths.find(path) == controllerPaths.end())
-        {
-            controller* instance = fromPath(node, path);
+    return controllers;
+}
 
-            if (instance)
-            {
-                controllers.push_back(shared_ptr<controller>(instance));
-                controllerPaths.insert(path);
-            }
-        }
+void controllerFactory::findControllers(
+    ros::NodeHandle node,
+    const string& path,
+    XmlRpc::XmlRpcValue& settings,
+    controllerArray& controllers)
+{
+    if (settings.getType() != XmlRpc::XmlRpcValue::TypeStruct)
+        return;
+
+    if (settings.hasMember("controller"))
+    {
+        controller* instance = fromSettings(node, path, settings);
+
+        if (instance)
+            controllers.push_back(shared_ptr<controller>(instance));
     }
 
-    return controllers;
+    for (auto child = settings.begin(); child != settings.end(); child++)
+    {
+        findControllers(node, path + "/" + child->first, child->second, controllers);
+    }
 }
 
 void controllerFactory::registerType(string type, createController create, bool shared)
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <map>
+#include <xmlrpcpp/XmlRpcValue.h>
 #include "controller.h"
 
 /*----------------------------------------------------------*\
@@ -93,19 +94,31 @@ public:
         return dynamic_cast<T*>(fromType(type));
     }
 
-    // Deserialize controller by path
+    // Deserialize controller by path, caller configures
     static controller* fromPath(ros::NodeHandle node, std::string path);
 
+    // Deserialize controller from settings subtree already fetched, caller configures
+    static controller* fromSettings(ros::NodeHandle node, std::string path, XmlRpc::XmlRpcValue& settings);
+
     // Deserialize controller by type
     static controller* fromType(std::string type);
 
-    // Deserialize all controllers in namespace
+    // Deserialize all controllers in namespace, caller configures
     static controllerArray fromNamespace(ros::NodeHandle node, std::string controllerNamespace);
 
+    // Deserialize all controllers in namespace settings tree already fetched, caller configures
+    static controllerArray fromNamespace(ros::NodeHandle node, std::string controllerNamespace, XmlRpc::XmlRpcValue& settings);
+
     // Register controller type
     static void registerType(std::string type, createController create, bool shared);
 
-    
+private:
+    // Find controllers in settings tree recursively
+    static void findControllers(
+        ros::NodeHandle node,
+        const std::string& path,
+        XmlRpc::XmlRpcValue& settings,
+        controllerArray& controllers);
 };
 
 } // namespace str1ker
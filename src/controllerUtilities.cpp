@@ -108,4 +108,96 @@ string controllerUtilities::getControllerPath(const string& path, const string&
     }
 
     return string();
-}
\ No newline at end of file
+}
+
+bool controllerUtilities::getSubtree(XmlRpc::XmlRpcValue& tree, const string& path, XmlRpc::XmlRpcValue& subtree)
+{
+    XmlRpc::XmlRpcValue* node = &tree;
+    size_t start = 0;
+
+    while (start < path.length())
+    {
+        size_t end = path.find('/', start);
+        if (end == string::npos) end = path.length();
+
+        if (end > start)
+        {
+            string name = path.substr(start, end - start);
+
+            if (node->getType() != XmlRpc::XmlRpcValue::TypeStruct || !node->hasMember(name))
+                return false;
+
+            node = &(*node)[name];
+        }
+
+        start = end + 1;
+    }
+
+    subtree = *node;
+
+    return true;
+}
+
+bool controllerUtilities::getSetting(XmlRpc::XmlRpcValue& settings, const string& name, bool& value)
+{
+    if (settings.getType() != XmlRpc::XmlRpcValue::TypeStruct || !settings.hasMember(name))
+        return false;
+
+    XmlRpc::XmlRpcValue& setting = settings[name];
+
+    if (setting.getType() == XmlRpc::XmlRpcValue::TypeBoolean)
+        value = bool(setting);
+    else if (setting.getType() == XmlRpc::XmlRpcValue::TypeInt)
+        value = int(setting) != 0;
+    else
+        return false;
+
+    return true;
+}
+
+bool controllerUtilities::getSetting(XmlRpc::XmlRpcValue& settings, const string& name, int& value)
+{
+    if (settings.getType() != XmlRpc::XmlRpcValue::TypeStruct || !settings.hasMember(name))
+        return false;
+
+    XmlRpc::XmlRpcValue& setting = settings[name];
+
+    if (setting.getType() != XmlRpc::XmlRpcValue::TypeInt)
+        return false;
+
+    value = int(setting);
+
+    return true;
+}
+
+bool controllerUtilities::getSetting(XmlRpc::XmlRpcValue& settings, const string& name, double& value)
+{
+    if (settings.getType() != XmlRpc::XmlRpcValue::TypeStruct || !settings.hasMember(name))
+        return false;
+
+    XmlRpc::XmlRpcValue& setting = settings[name];
+
+    if (setting.getType() == XmlRpc::XmlRpcValue::TypeDouble)
+        value = double(setting);
+    else if (setting.getType() == XmlRpc::XmlRpcValue::TypeInt)
+        value = double(int(setting));
+    else
+        return false;
+
+    return true;
+}
+
+bool controllerUtilities::getSetting(XmlRpc::XmlRpcValue& settings, const string& name, string& value)
+{
+    if (settings.getType() != XmlRpc::XmlRpcValue::TypeStruct || !settings.hasMember(name))
+        return false;
+
+    XmlRpc::XmlRpcValue& setting = settings[name];
+
+    if (setting.getType() != XmlRpc::XmlRpcValue::TypeString)
+        return false;
+
+    value = string(setting);
+
+    return true;
+}
@@ -23,6 +23,7 @@
 
 #include <string>
 #include <cstring>
+#include <xmlrpcpp/XmlRpcValue.h>
 
 /*----------------------------------------------------------*\
 | Namespace
@@ -39,4 +40,13 @@ namespace str1ker::controllerUtilities {
     string getParentName(const string& path);
     string getParentPath(const string& path);
     string getControllerPath(const string& path, const string& parentPath);
+
+    // Find subtree by path relative to tree root
+    bool getSubtree(XmlRpc::XmlRpcValue& tree, const string& path, XmlRpc::XmlRpcValue& subtree);
+
+    // Read setting from parameter tree, converting integers to floating point
+    bool getSetting(XmlRpc::XmlRpcValue& settings, const string& name, bool& value);
+    bool getSetting(XmlRpc::XmlRpcValue& settings, const string& name, int& value);
+    bool getSetting(XmlRpc::XmlRpcValue& settings, const string& name, double& value);
+    bool getSetting(XmlRpc::XmlRpcValue& settings, const string& name, string& value);
 } // namespace str1ker::controllerUtilities
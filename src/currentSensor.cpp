@@ -0,0 +1,202 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ currentSensor.cpp
+
+ Motor Current Sensor Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include "robot.h"
+#include "controllerFactory.h"
+#include "hardwareUtilities.h"
+#include "currentSensor.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+const char currentSensor::TYPE[] = "current_sensor";
+
+/*----------------------------------------------------------*\
+| currentSensor implementation
+\*----------------------------------------------------------*/
+
+REGISTER_CONTROLLER(currentSensor);
+
+//
+// Constructors
+//
+
+currentSensor::currentSensor(ros::NodeHandle node, string path)
+  : controller(node, TYPE, path)
+  , m_filter(DEFAULT_THRESHOLD, DEFAULT_AVERAGE)
+{
+}
+
+//
+// Configuration
+//
+
+bool currentSensor::configure()
+{
+  controller::configure();
+
+  if (!getSetting("topic", m_topic))
+    ROS_WARN("%s did not specify ADC input topic, using %s", getPath().c_str(), m_topic.c_str());
+
+  if (!getSetting("channel", m_channel))
+  {
+    ROS_ERROR("%s did not specify current sense input channel", getPath().c_str());
+    return false;
+  }
+
+  if (!getSetting("zeroReading", m_zeroReading))
+    ROS_WARN("%s did not specify zeroReading value, using %d", getPath().c_str(), m_zeroReading);
+
+  if (!getSetting("ampsPerReading", m_ampsPerReading))
+    ROS_WARN("%s did not specify ampsPerReading, using %g", getPath().c_str(), m_ampsPerReading);
+
+  if (!getSetting("effortPerAmp", m_effortPerAmp))
+    ROS_WARN("%s did not specify effortPerAmp, reporting effort in amps", getPath().c_str());
+
+  if (!getSetting("maxCurrent", m_maxCurrent))
+    ROS_WARN("%s did not specify maxCurrent, current limiting disabled", getPath().c_str());
+
+  if (!getSetting("stallCurrent", m_stallCurrent))
+    ROS_WARN("%s did not specify stallCurrent, stall detection disabled", getPath().c_str());
+
+  if (!getSetting("stallSeconds", m_stallSeconds))
+    ROS_WARN("%s did not specify stallSeconds, using %g", getPath().c_str(), m_stallSeconds);
+
+  if (!getSetting("stallDistance", m_stallDistance))
+    ROS_WARN("%s did not specify stallDistance, using %g", getPath().c_str(), m_stallDistance);
+
+  int threshold = DEFAULT_THRESHOLD, average = DEFAULT_AVERAGE;
+
+  if (!getSetting("threshold", threshold))
+    ROS_WARN("%s did not specify sample threshold, using %d", getPath().c_str(), DEFAULT_THRESHOLD);
+
+  if (!getSetting("average", average))
+    ROS_WARN("%s did not specify how many samples to average, using %d", getPath().c_str(), DEFAULT_AVERAGE);
+
+  m_filter = filter(threshold, average);
+
+  return true;
+}
+
+//
+// Initialization
+//
+
+bool currentSensor::init()
+{
+  m_sub = m_node.subscribe<Adc>(
+    m_topic, QUEUE_SIZE, &currentSensor::feedback, this);
+
+  ROS_INFO("  initialized %s %s on %s channel %d: (%d + reading) * %g A, limit %g A, stall %g A",
+    getPath().c_str(),
+    getType().c_str(),
+    m_topic.c_str(),
+    m_channel,
+    -m_zeroReading,
+    m_ampsPerReading,
+    m_maxCurrent,
+    m_stallCurrent);
+
+  return true;
+}
+
+//
+// Current limiting
+//
+
+double currentSensor::limit(double command, double position, ros::Time time)
+{
+  if (!m_enable || !m_ready) return command;
+
+  int direction = utilities::isZero(command) ? 0 : (command > 0.0 ? 1 : -1);
+
+  if (isStalled())
+  {
+    // Stay stopped until commanded to stop or reverse
+    if (direction == m_stallDirection) return 0.0;
+
+    ROS_INFO("%s stall cleared", getPath().c_str());
+    m_stallDirection = 0;
+    m_stallStart = ros::Time();
+  }
+
+  if (m_stallCurrent > 0.0 && direction != 0 && m_current >= m_stallCurrent)
+  {
+    if (m_stallStart.isZero() || abs(position - m_stallPosition) > m_stallDistance)
+    {
+      // High current while moving, restart the stall timer here
+      m_stallStart = time;
+      m_stallPosition = position;
+    }
+    else if ((time - m_stallStart).toSec() >= m_stallSeconds)
+    {
+      ROS_ERROR("%s stalled at %g A, stopping until command reverses", getPath().c_str(), m_current);
+      m_stallDirection = direction;
+      return 0.0;
+    }
+  }
+  else
+  {
+    m_stallStart = ros::Time();
+  }
+
+  if (m_maxCurrent > 0.0 && m_current > m_maxCurrent)
+  {
+    // Fold back in proportion to overcurrent
+    return command * m_maxCurrent / m_current;
+  }
+
+  return command;
+}
+
+//
+// Feedback
+//
+
+void currentSensor::feedback(const Adc::ConstPtr& msg)
+{
+  if (m_channel < 0 || m_channel >= int(msg->adc.size())) return;
+
+  m_reading = m_filter(msg->adc[m_channel]);
+  m_current = max(0, m_reading - m_zeroReading) * m_ampsPerReading;
+
+  if (!m_ready)
+  {
+    m_ready = m_filter.isStable();
+  }
+}
+
+//
+// Dynamic creation
+//
+
+controller* currentSensor::create(ros::NodeHandle node, string path)
+{
+  return new currentSensor(node, path);
+}
@@ -0,0 +1,174 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ currentSensor.h
+
+ Motor Current Sensor class
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <ros/ros.h>
+#include <str1ker/Adc.h>
+#include "controller.h"
+#include "filter.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| currentSensor class
+\*----------------------------------------------------------*/
+
+class currentSensor : public controller
+{
+public:
+  // Controller type
+  static const char TYPE[];
+
+private:
+  // Queue size for subscribers
+  const int QUEUE_SIZE = 8;
+
+  // Defaults for analog input filtering
+  const int DEFAULT_THRESHOLD = 4;
+  const int DEFAULT_AVERAGE = 4;
+
+  // Default conversion for BTS7960 IS pin into 1K resistor on 5V 10-bit ADC
+  const double DEFAULT_AMPS_PER_READING = 0.0415;
+
+  // Default stall detection time
+  const double DEFAULT_STALL_SECONDS = 0.5;
+
+private:
+  //
+  // Configuration
+  //
+
+  // Input topic for listening to analog readings
+  std::string m_topic = "adc";
+
+  // Analog input channel connected to driver current sense output
+  int m_channel = -1;
+
+  // Analog reading at zero current
+  int m_zeroReading = 0;
+
+  // Current in amps per analog reading
+  double m_ampsPerReading = DEFAULT_AMPS_PER_READING;
+
+  // Effort (force or torque) per amp
+  double m_effortPerAmp = 1.0;
+
+  // Current above which the command is scaled back (0 disables)
+  double m_maxCurrent = 0.0;
+
+  // Current above which the actuator may be stalled (0 disables)
+  double m_stallCurrent = 0.0;
+
+  // How long the current must stay high without moving to declare a stall
+  double m_stallSeconds = DEFAULT_STALL_SECONDS;
+
+  // Position change that counts as moving during stall detection
+  double m_stallDistance = 0.0;
+
+  //
+  // State
+  //
+
+  // Ready to provide readings
+  bool m_ready = false;
+
+  // Last filtered analog reading
+  int m_reading = 0;
+
+  // Last current in amps
+  double m_current = 0.0;
+
+  // Time when high current was first observed, zero if current is normal
+  ros::Time m_stallStart;
+
+  // Position when high current was first observed
+  double m_stallPosition = 0.0;
+
+  // Direction of the command that stalled, zero if not stalled
+  int m_stallDirection = 0;
+
+  // Filter for analog input
+  filter m_filter;
+
+  // Subscriber for receiving analog readings
+  ros::Subscriber m_sub;
+
+public:
+  //
+  // Constructors
+  //
+
+  currentSensor(ros::NodeHandle node, std::string path);
+
+public:
+  // Get last filtered analog reading
+  inline int getReading() const
+  {
+    return m_reading;
+  }
+
+  // Get last current in amps
+  inline double getCurrent() const
+  {
+    return m_current;
+  }
+
+  // Get effort magnitude mapped from current
+  inline double getEffort() const
+  {
+    return m_current * m_effortPerAmp;
+  }
+
+  // Determine if the sensor is ready to provide readings
+  inline bool isReady() const
+  {
+    return m_ready;
+  }
+
+  // Determine if the actuator is stalled
+  inline bool isStalled() const
+  {
+    return m_stallDirection != 0;
+  }
+
+  // Configuration
+  virtual bool configure();
+
+  // Initialization
+  virtual bool init();
+
+  // Limit velocity command based on measured current and position
+  double limit(double command, double position, ros::Time time);
+
+  // Analog reading feedback
+  void feedback(const Adc::ConstPtr& msg);
+
+public:
+  // Create instance
+  static controller* create(ros::NodeHandle node, std::string path);
+};
+
+} // namespace str1ker
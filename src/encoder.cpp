@@ -22,6 +22,7 @@
 #include "robot.h"
 #include "controllerFactory.h"
 #include "hardwareUtilities.h"
+#include "controllerUtilities.h"
 #include "encoder.h"
 
 /*----------------------------------------------------------*\
@@ -74,6 +75,8 @@ encoder::encoder(
   , m_maxReading(maxReading)
   , m_minPos(minPos)
   , m_maxPos(maxPos)
+  , m_threshold(filterThreshold)
+  , m_average(filterAverage)
   , m_ready(false)
 {
 }
@@ -86,43 +89,88 @@ bool encoder::configure()
 {
   controller::configure();
 
-  if (!ros::param::get(getChildPath("topic"), m_topic))
+  if (!getSetting("topic", m_topic))
     ROS_WARN("%s did not specify ADC input topic, using %s", getPath().c_str(), m_topic.c_str());
 
-  if (!ros::param::get(getChildPath("absoluteChannel"), m_absoluteChannel))
+  if (!getSetting("absoluteChannel", m_absoluteChannel))
     ROS_WARN("%s did not specify absolute input channel, using %d", getPath().c_str(), m_absoluteChannel);
 
-  if (!ros::param::get(getChildPath("quadratureChannel"), m_quadratureChannel))
+  if (!getSetting("quadratureChannel", m_quadratureChannel))
     ROS_INFO("%s did not specify quadrature input channel, offset tracking disabled", getPath().c_str());
 
-  if (!ros::param::get(getChildPath("quadratureScale"), m_quadratureScale) && m_quadratureChannel != -1)
+  if (!getSetting("quadratureScale", m_quadratureScale) && m_quadratureChannel != -1)
     ROS_ERROR("%s did not specify quadrature scale in relation to absolute range", getPath().c_str());
 
-  if (!ros::param::get(getChildPath("minReading"), m_minReading))
+  if (!getSetting("minReading", m_minReading))
     ROS_WARN("%s did not specify minReading value, using %d", getPath().c_str(), m_minReading);
 
-  if (!ros::param::get(getChildPath("maxReading"), m_maxReading))
+  if (!getSetting("maxReading", m_maxReading))
     ROS_WARN("%s did not specify maxReading value, using %d", getPath().c_str(), m_maxReading);
 
-  if (!ros::param::get(getChildPath("minPos"), m_minPos))
+  if (!getSetting("minPos", m_minPos))
     ROS_WARN("%s did not specify minPos value, using %g", getPath().c_str(), m_minPos);
 
-  if (!ros::param::get(getChildPath("maxPos"), m_maxPos))
+  if (!getSetting("maxPos", m_maxPos))
     ROS_WARN("%s did not specify maxPos value, using %g", getPath().c_str(), m_maxPos);
 
-  int threshold = DEFAULT_THRESHOLD, average = DEFAULT_AVERAGE;
+  if (!getSetting("threshold", m_threshold))
+    ROS_WARN("%s did not specify sample threshold, using %d", getPath().c_str(), m_threshold);
 
-  if (!ros::param::get(getChildPath("threshold"), threshold))
-    ROS_WARN("%s did not specify sample threshold, using %d", getPath().c_str(), DEFAULT_THRESHOLD);
+  if (!getSetting("average", m_average))
+    ROS_WARN("%s did not specify how many samples to average, using %d", getPath().c_str(), m_average);
 
-  if (!ros::param::get(getChildPath("average"), average))
-    ROS_WARN("%s did not specify how many samples to average, using %d", getPath().c_str(), DEFAULT_AVERAGE);
+  m_filter = filter(m_threshold, m_average);
 
-  m_filter = filter(threshold, average);
+  m_staged.quadratureScale = m_quadratureScale;
+  m_staged.minReading = m_minReading;
+  m_staged.maxReading = m_maxReading;
+  m_staged.minPos = m_minPos;
+  m_staged.maxPos = m_maxPos;
+  m_staged.threshold = m_threshold;
+  m_staged.average = m_average;
 
   return true;
 }
 
+//
+// Reload
+//
+
+bool encoder::stage(XmlRpc::XmlRpcValue& settings)
+{
+  // Topic and channels require a restart
+  reloadable_t staged = m_staged;
+
+  controllerUtilities::getSetting(settings, "quadratureScale", staged.quadratureScale);
+  controllerUtilities::getSetting(settings, "minReading", staged.minReading);
+  controllerUtilities::getSetting(settings, "maxReading", staged.maxReading);
+  controllerUtilities::getSetting(settings, "minPos", staged.minPos);
+  controllerUtilities::getSetting(settings, "maxPos", staged.maxPos);
+  controllerUtilities::getSetting(settings, "threshold", staged.threshold);
+  controllerUtilities::getSetting(settings, "average", staged.average);
+
+  if (staged.minReading == staged.maxReading)
+  {
+    ROS_ERROR("%s minReading and maxReading must differ", getPath().c_str());
+    return false;
+  }
+
+  if (staged.threshold < 0 || staged.average < 0)
+  {
+    ROS_ERROR("%s threshold and average must not be negative", getPath().c_str());
+    return false;
+  }
+
+  m_staged = staged;
+
+  return true;
+}
+
+void encoder::release()
+{
+  m_reload.publish(m_staged);
+}
+
 //
 // Initialization
 //
@@ -168,16 +216,49 @@ bool encoder::init()
 
 void encoder::feedback(const Adc::ConstPtr& msg)
 {
+  // Apply reloaded settings between readings
+  reloadable_t reloaded;
+
+  if (m_reload.consume(reloaded))
+  {
+    m_quadratureScale = reloaded.quadratureScale;
+    m_minReading = reloaded.minReading;
+    m_maxReading = reloaded.maxReading;
+    m_minPos = reloaded.minPos;
+    m_maxPos = reloaded.maxPos;
+    m_threshold = reloaded.threshold;
+    m_average = reloaded.average;
+
+    m_filter.reconfigure(m_threshold, m_average);
+
+    ROS_INFO("%s reloaded: [%d, %d] -> [%g, %g]",
+      getPath().c_str(), m_minReading, m_maxReading, m_minPos, m_maxPos);
+  }
+
   // Read absolute input
   m_reading = m_filter(msg->adc[m_absoluteChannel]);
 
   // Read quadrature input
-  if (m_quadratureChannel != -1)
+  if (m_quadratureChannel != -1 && m_quadratureChannel < int(msg->quadrature.size()))
   {
-    m_offset = msg->adc[m_quadratureChannel];
+    int32_t count = msg->quadrature[m_quadratureChannel];
+
+    m_offset = m_counting ? int(count - m_count) : 0;
+    m_count = count;
+    m_counting = true;
+
     m_fusedReading = m_filter.isStable()
       ? m_reading
       : m_fusedReading + int(double(m_offset) * m_quadratureScale);
+
+    if (m_quadratureChannel < int(msg->velocity.size()))
+    {
+      // Counts per second -> analog units per second -> joint units per second
+      m_velocity = double(msg->velocity[m_quadratureChannel]) * m_quadratureScale *
+        (m_maxPos - m_minPos) / double(m_maxReading - m_minReading);
+
+      m_hasVelocity = true;
+    }
   }
   else
   {
@@ -194,6 +275,7 @@ void encoder::feedback(const Adc::ConstPtr& msg)
 
   // Clamp to valid range
   m_position = utilities::clamp(position, m_minPos, m_maxPos);
+  m_samples.fetch_add(1, memory_order_release);
 
   // Check if the position is ready to be used
   if (!m_ready)
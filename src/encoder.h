@@ -21,9 +21,11 @@
 | Includes
 \*----------------------------------------------------------*/
 
+#include <atomic>
 #include <ros/ros.h>
 #include <str1ker/Adc.h>
 #include "controller.h"
+#include "configSnapshot.h"
 #include "filter.h"
 
 /*----------------------------------------------------------*\
@@ -58,6 +60,18 @@ private:
   const double POS_MIN = 0.0;
   const double POS_MAX = 1.0;
 
+  // Settings that can be reloaded while running
+  struct reloadable_t
+  {
+    double quadratureScale;
+    int minReading;
+    int maxReading;
+    double minPos;
+    double maxPos;
+    int threshold;
+    int average;
+  };
+
 private:
   //
   // Configuration
@@ -69,7 +83,7 @@ private:
   // Analog input channel for absolute readings
   int m_absoluteChannel;
 
-  // Digital input channel for relative readings (optional)
+  // Quadrature encoder channel for relative readings (optional)
   int m_quadratureChannel = -1;
 
   // Quadrature mapping to absolute range
@@ -87,6 +101,18 @@ private:
   // Position (joint state) max
   double m_maxPos = POS_MAX;
 
+  // Filter sample threshold
+  int m_threshold = DEFAULT_THRESHOLD;
+
+  // Filter moving average size
+  int m_average = DEFAULT_AVERAGE;
+
+  // Settings staged by reload, owned by reload thread
+  reloadable_t m_staged;
+
+  // Settings handed from reload thread to feedback
+  configSnapshot<reloadable_t> m_reload;
+
   //
   // State
   //
@@ -97,7 +123,13 @@ private:
   // Last filtered analog reading
   int m_reading = -1;
 
-  // Last relative quadrature reading
+  // Last quadrature count
+  int32_t m_count = 0;
+
+  // Whether a quadrature count was received
+  bool m_counting = false;
+
+  // Quadrature count change since previous reading
   int m_offset = 0;
 
   // Last fused reading from absolute/relative inputs
@@ -106,6 +138,15 @@ private:
   // Last position mapped from last reading
   double m_position = std::numeric_limits<double>::infinity();
 
+  // Last velocity mapped from quadrature velocity estimate
+  double m_velocity = 0.0;
+
+  // Whether velocity estimate is available
+  bool m_hasVelocity = false;
+
+  // Positions mapped so far, published after each position
+  std::atomic<uint32_t> m_samples{ 0 };
+
   // Filter for analog input
   filter m_filter;
 
@@ -151,6 +192,24 @@ public:
     return m_position;
   }
 
+  // Whether a quadrature channel measures velocity
+  inline bool hasQuadrature() const
+  {
+    return m_quadratureChannel >= 0;
+  }
+
+  // Get current velocity estimated by the quadrature encoder
+  inline double getVelocity() const
+  {
+    return m_velocity;
+  }
+
+  // Determine if the quadrature encoder provides velocity
+  inline bool hasVelocity() const
+  {
+    return m_hasVelocity;
+  }
+
   // Get minimum position
   inline double getMin() const
   {
@@ -163,6 +222,41 @@ public:
     return m_maxPos;
   }
 
+  // Get analog input channel
+  inline int getAbsoluteChannel() const
+  {
+    return m_absoluteChannel;
+  }
+
+  // Get quadrature encoder channel, -1 if not used
+  inline int getQuadratureChannel() const
+  {
+    return m_quadratureChannel;
+  }
+
+  // Get quadrature count mapping to analog readings
+  inline double getQuadratureScale() const
+  {
+    return m_quadratureScale;
+  }
+
+  // Get analog reading range
+  inline int getMinReading() const
+  {
+    return m_minReading;
+  }
+
+  inline int getMaxReading() const
+  {
+    return m_maxReading;
+  }
+
+  // Get number of positions mapped so far, changes when a new position is available
+  inline uint32_t getSamples() const
+  {
+    return m_samples.load(std::memory_order_acquire);
+  }
+
   // Determine if the absolute encoder is ready to provide readings
   bool isReady() const
   {
@@ -175,6 +269,12 @@ public:
   // Initialization
   virtual bool init();
 
+  // Validate reloaded settings
+  virtual bool stage(XmlRpc::XmlRpcValue& settings);
+
+  // Hand staged settings to feedback
+  virtual void release();
+
   // Analog reading feedback
   void feedback(const Adc::ConstPtr& msg);
 
@@ -49,6 +49,26 @@ filter::filter(int threshold, int average)
 {
 }
 
+//
+// Change settings without losing history
+//
+
+void filter::reconfigure(int threshold, int average)
+{
+  m_threshold = threshold;
+
+  if (average == m_average) return;
+
+  // Seed resized average buffer with last output so it doesn't jump
+  int last = m_average
+    ? m_buffer[(m_next + m_average - 1) % m_average]
+    : (m_max != -1 ? m_max : 0);
+
+  m_average = average;
+  m_buffer.assign(average, last);
+  m_next = 0;
+}
+
 //
 // Filter a sample
 //
@@ -69,6 +69,12 @@ public:
 
   filter(int threshold, int average);
 
+  //
+  // Configuration
+  //
+
+  void reconfigure(int threshold, int average);
+
   //
   // Sampling
   //
@@ -0,0 +1,327 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ frictionCalibration.cpp
+
+ Friction and Backlash Calibration
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <algorithm>
+#include "frictionCalibration.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace std;
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| frictionCalibration implementation
+\*----------------------------------------------------------*/
+
+//
+// Lifecycle
+//
+
+void frictionCalibration::start(
+  double minPos,
+  double maxPos,
+  double maxPwm,
+  double maxVelocity,
+  const settings_t& settings)
+{
+  m_settings = settings;
+  m_minPos = minPos;
+  m_maxPos = maxPos;
+  m_maxPwm = maxPwm;
+  m_movingVelocity = settings.movingFraction * maxVelocity;
+
+  m_phase = RAMP;
+  m_index = 0;
+  m_lastDirection = 0.0;
+  m_breakaway[0] = m_breakaway[1] = 0.0;
+  m_reverseDelay = 0.0;
+  m_sameDelay = -1.0;
+  m_samePos = 0.0;
+  m_result = result_t();
+  m_error = nullptr;
+
+  m_strokes.clear();
+  m_strokes.reserve(max(settings.levels, 0));
+
+  // Rest from the first update so the joint starts from a standstill
+  m_resting = true;
+  m_restUntil = -1.0;
+}
+
+void frictionCalibration::abort()
+{
+  if (!isDone()) fail("aborted");
+}
+
+//
+// Calibration
+//
+
+double frictionCalibration::update(double time, double position, double velocity)
+{
+  if (isDone()) return 0.0;
+
+  if (m_resting)
+  {
+    if (m_restUntil < 0.0) m_restUntil = time + m_settings.settleTime;
+    if (time < m_restUntil) return 0.0;
+
+    m_resting = false;
+
+    // Strokes head for the limit with more room, so consecutive strokes alternate
+    double room = m_maxPos - position > position - m_minPos ? 1.0 : -1.0;
+
+    switch (m_phase)
+    {
+      case RAMP:
+        begin(time, m_index ? -m_lastDirection : room);
+        break;
+
+      case STROKE:
+        begin(time, room);
+        break;
+
+      case BACKLASH_REVERSE:
+        begin(time, -m_lastDirection);
+        break;
+
+      default:
+        begin(time, m_lastDirection);
+        break;
+    }
+  }
+
+  double elapsed = time - m_start;
+  bool moving = m_direction * velocity > m_movingVelocity;
+  bool ended = isBlocked(position) || elapsed > m_settings.moveTimeout;
+
+  switch (m_phase)
+  {
+    case RAMP:
+    {
+      if (moving)
+      {
+        // Duty cycle overshoots by the ramp over reading delay, keep the ramp slow
+        m_breakaway[m_direction > 0.0 ? 0 : 1] = m_pwm;
+        m_lastDirection = m_direction;
+
+        if (++m_index == 2)
+        {
+          m_phase = STROKE;
+          m_index = 0;
+        }
+
+        rest(time);
+        return 0.0;
+      }
+
+      if (ended)
+      {
+        fail(isBlocked(position)
+          ? "reached position limit before moving, start away from limits"
+          : "did not move at max duty cycle");
+
+        return 0.0;
+      }
+
+      m_pwm = min(m_maxPwm, m_settings.rampRate * elapsed);
+      break;
+    }
+
+    case STROKE:
+    {
+      if (ended)
+      {
+        double average = m_velocitySamples ? m_velocitySum / m_velocitySamples : 0.0;
+
+        // Strokes that stalled or ended before settling tell nothing about friction
+        if (average > m_movingVelocity)
+          m_strokes.push_back({ m_pwm, average });
+
+        m_lastDirection = m_direction;
+
+        if (++m_index == m_settings.levels)
+        {
+          fit();
+          if (isDone()) return 0.0;
+
+          m_phase = BACKLASH_REVERSE;
+        }
+
+        rest(time);
+        return 0.0;
+      }
+
+      // Average steady velocity once the actuator accelerated
+      if (elapsed >= m_settings.settleTime)
+      {
+        m_velocitySum += m_direction * velocity;
+        m_velocitySamples++;
+      }
+
+      break;
+    }
+
+    case BACKLASH_REVERSE:
+    {
+      if (moving)
+      {
+        // Reversing from rest crosses the gap before the output moves
+        m_reverseDelay = elapsed;
+        m_lastDirection = m_direction;
+        m_phase = BACKLASH_SAME;
+
+        rest(time);
+        return 0.0;
+      }
+
+      if (ended)
+      {
+        fail("did not move while measuring backlash");
+        return 0.0;
+      }
+
+      break;
+    }
+
+    case BACKLASH_SAME:
+    {
+      // Starting again in the same direction the gap is closed and the output follows the motor,
+      // so travel between the moments motion was detected in both moves is the gap
+      if (moving && m_sameDelay < 0.0)
+      {
+        m_sameDelay = elapsed;
+        m_samePos = position;
+      }
+
+      if (m_sameDelay >= 0.0 && (elapsed >= m_reverseDelay || ended))
+      {
+        m_result.backlash = max(0.0, m_direction * (position - m_samePos));
+        m_phase = DONE;
+
+        return 0.0;
+      }
+
+      if (ended)
+      {
+        fail("did not move while measuring backlash");
+        return 0.0;
+      }
+
+      break;
+    }
+
+    default:
+      return 0.0;
+  }
+
+  return m_direction * m_pwm;
+}
+
+void frictionCalibration::rest(double time)
+{
+  m_resting = true;
+  m_restUntil = time + m_settings.settleTime;
+}
+
+void frictionCalibration::begin(double time, double direction)
+{
+  m_start = time;
+  m_direction = direction;
+  m_velocitySum = 0.0;
+  m_velocitySamples = 0;
+
+  if (m_phase == RAMP)
+  {
+    m_pwm = 0.0;
+  }
+  else if (m_phase == STROKE)
+  {
+    // Spread strokes from breakaway to max duty cycle, last stroke at max
+    double breakaway = max(m_breakaway[0], m_breakaway[1]);
+    m_pwm = breakaway + (m_maxPwm - breakaway) * (m_index + 1) / m_settings.levels;
+  }
+  else
+  {
+    m_pwm = m_maxPwm;
+  }
+}
+
+bool frictionCalibration::isBlocked(double position) const
+{
+  double margin = m_settings.margin * (m_maxPos - m_minPos);
+
+  return m_direction > 0.0
+    ? position >= m_maxPos - margin
+    : position <= m_minPos + margin;
+}
+
+void frictionCalibration::fit()
+{
+  size_t count = m_strokes.size();
+
+  if (count < 2)
+  {
+    fail("too few strokes reached a steady velocity");
+    return;
+  }
+
+  // Least squares line through duty cycle over velocity
+  double meanVelocity = 0.0, meanPwm = 0.0;
+
+  for (const stroke_t& stroke : m_strokes)
+  {
+    meanVelocity += stroke.velocity / count;
+    meanPwm += stroke.pwm / count;
+  }
+
+  double sxx = 0.0, sxy = 0.0;
+
+  for (const stroke_t& stroke : m_strokes)
+  {
+    sxx += (stroke.velocity - meanVelocity) * (stroke.velocity - meanVelocity);
+    sxy += (stroke.velocity - meanVelocity) * (stroke.pwm - meanPwm);
+  }
+
+  if (sxx <= 0.0 || sxy <= 0.0)
+  {
+    fail("velocity did not increase with duty cycle");
+    return;
+  }
+
+  double breakaway = max(m_breakaway[0], m_breakaway[1]);
+
+  m_result.breakawayPwm = breakaway;
+  m_result.viscousPwm = sxy / sxx;
+  m_result.coulombPwm = min(max(meanPwm - m_result.viscousPwm * meanVelocity, 0.0), breakaway);
+
+  // Breakaway friction fades by the velocity Coulomb and viscous friction alone reach at breakaway
+  m_result.stribeckVelocity = max(
+    (breakaway - m_result.coulombPwm) / m_result.viscousPwm, m_movingVelocity);
+}
+
+void frictionCalibration::fail(const char* error)
+{
+  m_error = error;
+  m_phase = FAILED;
+}
@@ -0,0 +1,202 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ frictionCalibration.h
+
+ Friction and Backlash Calibration
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <vector>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| frictionCalibration class
+\*----------------------------------------------------------*/
+
+class frictionCalibration
+{
+public:
+  // Calibration settings
+  struct settings_t
+  {
+    // PWM duty cycle increase per second while looking for breakaway
+    double rampRate = 50.0;
+
+    // Fraction of max velocity that counts as moving
+    double movingFraction = 0.05;
+
+    // Time to rest between moves and to skip before averaging velocity
+    double settleTime = 0.5;
+
+    // Longest time a single move may take
+    double moveTimeout = 10.0;
+
+    // Fraction of travel kept clear of each position limit
+    double margin = 0.1;
+
+    // Number of constant duty cycle strokes for fitting friction
+    int levels = 4;
+  };
+
+  // Identified friction model in PWM duty cycle units
+  struct result_t
+  {
+    // Duty cycle that starts motion from rest
+    double breakawayPwm = 0.0;
+
+    // Duty cycle that keeps the actuator moving at vanishing velocity
+    double coulombPwm = 0.0;
+
+    // Duty cycle per unit of velocity
+    double viscousPwm = 0.0;
+
+    // Velocity over which breakaway friction decays to Coulomb friction
+    double stribeckVelocity = 0.0;
+
+    // Travel lost to gear backlash on direction reversal
+    double backlash = 0.0;
+  };
+
+private:
+  enum phase_t
+  {
+    RAMP,
+    STROKE,
+    BACKLASH_REVERSE,
+    BACKLASH_SAME,
+    DONE,
+    FAILED
+  };
+
+  struct stroke_t
+  {
+    double pwm;
+    double velocity;
+  };
+
+private:
+  // Settings
+  settings_t m_settings;
+
+  // Position limits and velocity range
+  double m_minPos = 0.0;
+  double m_maxPos = 0.0;
+  double m_maxPwm = 0.0;
+  double m_movingVelocity = 0.0;
+
+  // Current phase and its index within phase
+  phase_t m_phase = DONE;
+  int m_index = 0;
+
+  // Whether resting before the next move, and until when
+  bool m_resting = false;
+  double m_restUntil = 0.0;
+
+  // Current move: start time, direction and duty cycle
+  double m_start = 0.0;
+  double m_direction = 0.0;
+  double m_pwm = 0.0;
+
+  // Direction of the last move
+  double m_lastDirection = 0.0;
+
+  // Velocity averaged over current stroke
+  double m_velocitySum = 0.0;
+  int m_velocitySamples = 0;
+
+  // Breakaway duty cycle in each direction
+  double m_breakaway[2] = { 0.0, 0.0 };
+
+  // Steady velocity of each stroke
+  std::vector<stroke_t> m_strokes;
+
+  // Time until motion after reversing from rest
+  double m_reverseDelay = 0.0;
+
+  // Time until motion and position at that time when continuing in the same direction
+  double m_sameDelay = -1.0;
+  double m_samePos = 0.0;
+
+  // Identified model
+  result_t m_result;
+
+  // Reason calibration failed
+  const char* m_error = nullptr;
+
+public:
+  // Begin calibrating an actuator, strokes are reserved here so update never allocates
+  void start(
+    double minPos,
+    double maxPos,
+    double maxPwm,
+    double maxVelocity,
+    const settings_t& settings);
+
+  // Advance calibration with joint state, returns signed PWM duty cycle to drive
+  double update(double time, double position, double velocity);
+
+  // Stop calibrating
+  void abort();
+
+  // Whether calibration ended
+  inline bool isDone() const
+  {
+    return m_phase == DONE || m_phase == FAILED;
+  }
+
+  // Whether calibration identified a model
+  inline bool isSuccessful() const
+  {
+    return m_phase == DONE;
+  }
+
+  // Get identified model
+  inline const result_t& getResult() const
+  {
+    return m_result;
+  }
+
+  // Get reason calibration failed
+  inline const char* getError() const
+  {
+    return m_error ? m_error : "";
+  }
+
+private:
+  // Rest before the next move
+  void rest(double time);
+
+  // Begin move toward the limit with more room
+  void begin(double time, double direction);
+
+  // Whether the next position is within margin of the limit ahead
+  bool isBlocked(double position) const;
+
+  // Fit Coulomb and viscous friction to strokes and finish
+  void fit();
+
+  // End calibration with an error
+  void fail(const char* error);
+};
+
+} // namespace str1ker
@@ -19,7 +19,13 @@
 \*----------------------------------------------------------*/
 
 #include <set>
+#include <cmath>
+#include <cstring>
 #include "controllerFactory.h"
+#include "controllerUtilities.h"
+#include "asyncLog.h"
+#include "trace.h"
+#include "recorder.h"
 #include "hardware.h"
 
 /*----------------------------------------------------------*\
@@ -38,21 +44,68 @@ hardware::hardware(ros::NodeHandle node, string configNamespace)
     , m_namespace(configNamespace)
     , m_controllerManager(this, node)
     , m_rate(DEFAULT_RATE)
+    , m_telemetryTopic("adc")
+    , m_heartbeatTopic("pwm")
+    , m_telemetryTimeout(DEFAULT_TELEMETRY_TIMEOUT)
+    , m_gravityCompensation(false)
+    , m_inverseDynamics(false)
+    , m_calibrationTimeout(DEFAULT_CALIBRATION_TIMEOUT)
+    , m_calibrationPending(false)
+    , m_calibrating(false)
+    , m_calibrationAbort(false)
     , m_lastUpdate(0)
+    , m_firstUpdate(0)
+    , m_lastTelemetry(0)
+    , m_deviceMissed(0)
+    , m_deviceTimeouts(0)
+    , m_reset(false)
     , m_debug(false)
+    , m_traceLast(0)
+    , m_tracePending(0)
+    , m_traceSent(0)
+    , m_probeId(0)
+    , m_transportDelay(0.0)
+    , m_recordSize(DEFAULT_RECORD_SIZE)
+    , m_replaying(false)
+    , m_profile(false)
+    , m_running(true)
 {
 }
 
 bool hardware::configure()
 {
-    // Load settings
+    // Load settings in one request
 
-    ros::param::get(m_namespace + "/publish_rate", m_rate);
-    ros::param::get(m_namespace + "/debug", m_debug);
+    XmlRpc::XmlRpcValue settings;
 
-    // Load controllers
+    if (!ros::param::get(m_namespace, settings))
+    {
+        ROS_ERROR("no settings found in %s", m_namespace.c_str());
+        return false;
+    }
+
+    controllerUtilities::getSetting(settings, "publish_rate", m_rate);
+    controllerUtilities::getSetting(settings, "debug", m_debug);
+    controllerUtilities::getSetting(settings, "telemetry_topic", m_telemetryTopic);
+    controllerUtilities::getSetting(settings, "telemetry_timeout", m_telemetryTimeout);
+    controllerUtilities::getSetting(settings, "heartbeat_topic", m_heartbeatTopic);
+    controllerUtilities::getSetting(settings, "trace_file", m_traceFile);
+
+    if (!m_traceFile.empty()) trace::enable();
 
-    m_controllers = controllerFactory::fromNamespace(m_node, m_namespace);
+    controllerUtilities::getSetting(settings, "record_file", m_recordFile);
+    controllerUtilities::getSetting(settings, "record_size", m_recordSize);
+    controllerUtilities::getSetting(settings, "profile", m_profile);
+    controllerUtilities::getSetting(settings, "gravity_compensation", m_gravityCompensation);
+    controllerUtilities::getSetting(settings, "inverse_dynamics", m_inverseDynamics);
+    controllerUtilities::getSetting(settings, "calibration_ramp_rate", m_calibrationSettings.rampRate);
+    controllerUtilities::getSetting(settings, "calibration_levels", m_calibrationSettings.levels);
+    controllerUtilities::getSetting(settings, "calibration_settle_time", m_calibrationSettings.settleTime);
+    controllerUtilities::getSetting(settings, "calibration_timeout", m_calibrationTimeout);
+
+    // Load controllers from settings
+
+    m_controllers = controllerFactory::fromNamespace(m_node, m_namespace, settings);
 
     for (auto controller : m_controllers)
     {
@@ -86,6 +139,36 @@ bool hardware::configure()
 
                     m_limits[jointName] = limits;
                 }
+
+                if (controller->getType() == motor::TYPE)
+                {
+                    updateDeceleration(dynamic_cast<motor*>(controller.get()));
+                }
+            }
+
+            if (m_gravityCompensation || m_inverseDynamics)
+            {
+                vector<string> joints;
+
+                for (auto& group : m_groups)
+                    joints.push_back(group.first);
+
+                if (m_dynamics.init(model, joints))
+                {
+                    m_dynamicsPos.resize(joints.size());
+                    m_dynamicsVel.resize(joints.size());
+                    m_dynamicsAccel.resize(joints.size());
+                    m_dynamicsCmd.resize(joints.size());
+                    m_feedforward.resize(joints.size());
+
+                    ROS_INFO("effort feedforward for %d joints over %d links",
+                        (int)joints.size(), m_dynamics.getLinkCount());
+                }
+                else
+                {
+                    ROS_WARN("no links in robot_description, effort feedforward disabled");
+                    m_gravityCompensation = m_inverseDynamics = false;
+                }
             }
         }
     }
@@ -113,6 +196,7 @@ bool hardware::init()
     {
         m_pos[group.first] = 0.0;
         m_vel[group.first] = 0.0;
+        m_measured[group.first] = false;
         m_effort[group.first] = 0.0;
         m_cmd[group.first] = 0.0;
 
@@ -135,6 +219,9 @@ bool hardware::init()
         m_cmd[group.first] = 0.0;
         m_velInterface.registerHandle(actuatorVelocity);
 
+        // Solenoid commands are strike events, not velocities to saturate
+        if (getSolenoid(group.first)) continue;
+
         // Register limits interface
         hardware_interface::JointStateHandle jointState(
             group.first,
@@ -145,7 +232,7 @@ bool hardware::init()
 
         hardware_interface::JointHandle jointHandle(
             jointState,
-            &m_vel[group.first]
+            &m_cmd[group.first]
         );
 
         joint_limits_interface::VelocityJointSaturationHandle
@@ -160,34 +247,461 @@ bool hardware::init()
     registerInterface(&m_velInterface);
     registerInterface(&m_satInterface);
 
+    // Allocate cycle record once, recording never allocates
+
+    m_cycleRecord.resize(sizeof(int64_t) + m_cmd.size() * sizeof(double));
+
+    // Initialize watchdog
+
+    m_telemetrySub = m_node.subscribe<Adc>(
+        m_telemetryTopic, QUEUE_SIZE, &hardware::telemetry, this);
+
+    m_heartbeatPub = m_node.advertise<Pwm>(m_heartbeatTopic, QUEUE_SIZE);
+
+    // Never modified, so the same message can be shared with every subscriber
+    m_heartbeat.reset(new Pwm());
+    m_statusPub.reset(
+        new realtime_tools::RealtimePublisher<HardwareStatus>(m_node, "hardware_status", QUEUE_SIZE));
+
+    // Initialize settings reload
+
+    m_reloadService = m_node.advertiseService(
+        m_namespace + "/reload", &hardware::reload, this);
+
+    // Initialize friction calibration
+
+    for (auto& group : m_groups)
+    {
+        motor* mtr = getMotor(group.first);
+        if (!mtr) continue;
+
+        // Commanded velocity echoed back can't show whether the output moved
+        mtr->setVelocityMeasured(hasVelocitySource(group.first));
+
+        if (mtr->wantsCompensation() && !hasVelocitySource(group.first))
+        {
+            ROS_WARN("%s has no quadrature channel or enabled observer, friction compensation and calibration disabled",
+                mtr->getPath().c_str());
+        }
+
+        if (mtr->shouldCalibrate())
+            m_calibrations[group.first] = frictionCalibration();
+    }
+
+    m_calibrateService = m_node.advertiseService(
+        m_namespace + "/calibrate_friction", &hardware::calibrate, this);
+
+    m_calibrationPub = m_node.advertise<CalibrationStatus>(
+        m_namespace + "/calibration_status", 1, true);
+
+    m_calibrationTimer = m_node.createWallTimer(
+        ros::WallDuration(CALIBRATION_POLL_PERIOD), &hardware::calibrationTimer, this);
+
     return true;
 }
 
-void hardware::update()
+void hardware::update(ros::Time time)
 {
-    ros::Time time = ros::Time::now();
     ros::Duration period = time - m_lastUpdate;
 
-    read();
+    if (m_profile && !m_profiler.isOpen()) startProfiling();
 
-    for (auto controller: m_controllers)
+    m_profiler.begin();
+
+    // Apply reloaded settings at cycle boundary
+    for (auto& controller: m_controllers)
+    {
+        if (controller->commit() && controller->getType() == motor::TYPE)
+            updateDeceleration(dynamic_cast<motor*>(controller.get()));
+    }
+
+    m_profiler.end(profiler::RELOAD);
+
+    read(period);
+
+    m_profiler.end(profiler::READ);
+
+    for (auto& controller: m_controllers)
         controller->update(time, period);
 
-    m_controllerManager.update(time, period);
-    m_satInterface.enforceLimits(period);
+    m_profiler.end(profiler::CONTROLLERS);
 
-    if (m_debug) debug();
+    if (watchdog(time))
+    {
+        // Hold actuators and restart controllers once readings resume
+        stopCalibration();
+        stop();
+        recordCycle(time);
+        m_reset = true;
 
-    write();
+        m_profiler.end(profiler::CONTROL);
+    }
+    else
+    {
+        // Replay loads recorded commands instead
+        if (!m_replaying) m_controllerManager.update(time, period, m_reset);
+
+        recordCycle(time);
+
+        m_profiler.end(profiler::CONTROL);
+
+        m_satInterface.enforceLimits(period);
+        enforcePositionLimits(period);
+        m_reset = false;
+
+        m_profiler.end(profiler::LIMITS);
+
+        if (m_debug) debug();
+
+        updateFeedforward(period);
+        write(time, period);
+
+        m_profiler.end(profiler::WRITE);
+    }
+
+    // Keep device outputs alive, an empty request is enough
+    recorder::write(recorder::PWM, *m_heartbeat);
+    m_heartbeatPub.publish(m_heartbeat);
+
+    // Publish phase counts up to the previous cycle
+    if (m_profiler.isOpen()) updateProfile();
+
+    m_status.header.stamp = time;
+    m_status.transport_delay = m_transportDelay.load(memory_order_relaxed);
+
+    // Skip a cycle rather than wait if the last status is still being sent
+    if (m_statusPub->trylock())
+    {
+        m_statusPub->msg_ = m_status;
+        m_statusPub->unlockAndPublish();
+    }
+
+    m_profiler.end(profiler::PUBLISH);
 
     m_lastUpdate = time;
 }
 
-void hardware::read()
+void hardware::enforcePositionLimits(ros::Duration period)
+{
+    for (auto& deceleration: m_deceleration)
+    {
+        auto& limits = m_limits[deceleration.first];
+
+        if (deceleration.second <= 0.0 || !limits.has_position_limits)
+            continue;
+
+        double pos = m_pos[deceleration.first];
+        double& cmd = m_cmd[deceleration.first];
+
+        // Distance left after traveling at measured velocity until the next update,
+        // only toward the limit being approached and only when velocity is measured
+        double vel = m_vel[deceleration.first];
+        bool measured = m_measured[deceleration.first] && isfinite(vel);
+        double travel = measured ? vel * period.toSec() : 0.0;
+        double upper = max(limits.max_position - pos - max(travel, 0.0), 0.0);
+        double lower = max(pos - limits.min_position + min(travel, 0.0), 0.0);
+
+        // Fastest velocity that can still stop within the distance: v² = 2ad
+        double maxVel = sqrt(2.0 * deceleration.second * upper);
+        double minVel = -sqrt(2.0 * deceleration.second * lower);
+
+        if (cmd > maxVel) cmd = maxVel;
+        if (cmd < minVel) cmd = minVel;
+    }
+}
+
+bool hardware::watchdog(ros::Time time)
+{
+    // Device turned off outputs: resend commands even if unchanged
+    uint32_t deviceTimeouts = m_deviceTimeouts;
+
+    if (deviceTimeouts != m_status.device_timeouts)
+    {
+        ROS_WARN("device watchdog turned off outputs, restoring commands");
+
+        for (auto controller: m_controllers)
+        {
+            if (controller->getType() == motor::TYPE)
+                dynamic_cast<motor*>(controller.get())->reset();
+        }
+    }
+
+    m_status.device_timeouts = deviceTimeouts;
+    m_status.device_missed = m_deviceMissed;
+
+    // Readings stopped or never arrived: positions are stale
+    if (m_firstUpdate.isZero()) m_firstUpdate = time;
+
+    uint64_t last = m_lastTelemetry;
+    if (!last) last = m_firstUpdate.toNSec();
+
+    // Readings stamped after this cycle started are fresh, not a wrapped-around timeout
+    int64_t elapsed = max(int64_t(time.toNSec()) - int64_t(last), int64_t(0));
+    bool faulted = elapsed > int64_t(m_telemetryTimeout * 1e9);
+
+    if (faulted && !m_status.faulted)
+    {
+        ROS_ERROR("no readings on %s for %g sec, stopping controllers",
+            m_telemetryTopic.c_str(), m_telemetryTimeout);
+
+        m_status.telemetry_timeouts++;
+    }
+    else if (!faulted && m_status.faulted)
+    {
+        ROS_INFO("readings resumed on %s, restarting controllers", m_telemetryTopic.c_str());
+    }
+
+    m_status.faulted = faulted;
+
+    return faulted;
+}
+
+void hardware::stop()
+{
+    for (auto& cmd: m_cmd)
+        cmd.second = 0.0;
+
+    for (auto controller: m_controllers)
+    {
+        if (controller->getType() == motor::TYPE)
+            dynamic_cast<motor*>(controller.get())->command(0.0);
+    }
+}
+
+void hardware::updateDeceleration(motor* mtr)
 {
-    for (auto group : m_groups)
+    auto jointName = mtr->getParentName();
+    auto& limits = m_limits[jointName];
+
+    // Prefer actuator setting, fall back to joint limits
+    m_deceleration[jointName] = mtr->getDeceleration() > 0.0
+        ? mtr->getDeceleration()
+        : (limits.has_acceleration_limits ? limits.max_acceleration : 0.0);
+}
+
+bool hardware::calibrate(std_srvs::Trigger::Request& request, std_srvs::Trigger::Response& response)
+{
+    lock_guard<mutex> lock(m_calibrationLock);
+
+    if (m_calibrations.empty())
+    {
+        response.success = false;
+        response.message = "no actuators with measured velocity enable calibrate in " + m_namespace;
+        return true;
+    }
+
+    if (m_calibrationPending)
     {
-        for (auto controller: group.second)
+        response.success = false;
+        response.message = "friction calibration already in progress";
+        return true;
+    }
+
+    for (auto& calibration : m_calibrations)
+    {
+        if (!m_limits[calibration.first].has_position_limits)
+        {
+            response.success = false;
+            response.message = calibration.first + " has no position limits to calibrate within";
+            return true;
+        }
+    }
+
+    for (auto& calibration : m_calibrations)
+    {
+        const joint_limits_interface::JointLimits& limits = m_limits[calibration.first];
+        motor* mtr = getMotor(calibration.first);
+
+        calibration.second.start(
+            limits.min_position,
+            limits.max_position,
+            mtr->getMaxPwm(),
+            mtr->getMaxVelocity(),
+            m_calibrationSettings);
+    }
+
+    ROS_INFO("calibrating friction of %d actuators", (int)m_calibrations.size());
+
+    // Update loop owns calibrations until it clears the flag, the timer applies results
+    m_calibrationDeadline = ros::WallTime::now() + ros::WallDuration(m_calibrationTimeout);
+    m_calibrationPending = true;
+    m_calibrationAbort.store(false, memory_order_relaxed);
+    m_calibrating.store(true, memory_order_release);
+
+    publishCalibration(true, false, "");
+
+    response.success = true;
+    response.message = "calibration started, see " + m_calibrationPub.getTopic();
+
+    return true;
+}
+
+void hardware::calibrationTimer(const ros::WallTimerEvent& event)
+{
+    lock_guard<mutex> lock(m_calibrationLock);
+
+    if (!m_calibrationPending) return;
+
+    if (m_calibrating.load(memory_order_acquire) && m_running)
+    {
+        if (!ros::ok() || ros::WallTime::now() > m_calibrationDeadline)
+            m_calibrationAbort.store(true, memory_order_relaxed);
+
+        return;
+    }
+
+    m_calibrationPending = false;
+
+    // Store identified models with the rest of the settings, then apply them like edited settings
+    bool success = true;
+    string message;
+
+    for (auto& calibration : m_calibrations)
+    {
+        const frictionCalibration& result = calibration.second;
+        string path = getMotor(calibration.first)->getPath();
+
+        if (!result.isSuccessful())
+        {
+            ROS_ERROR("%s friction calibration failed: %s", path.c_str(), result.getError());
+
+            success = false;
+            message += calibration.first + " failed: " + result.getError() + "\n";
+            continue;
+        }
+
+        const frictionCalibration::result_t& model = result.getResult();
+
+        ros::param::set(path + "/breakawayPwm", model.breakawayPwm);
+        ros::param::set(path + "/coulombPwm", model.coulombPwm);
+        ros::param::set(path + "/viscousPwm", model.viscousPwm);
+        ros::param::set(path + "/stribeckVelocity", model.stribeckVelocity);
+        ros::param::set(path + "/backlash", model.backlash);
+
+        ROS_INFO("%s breakaway %g coulomb %g viscous %g stribeck %g backlash %g",
+            path.c_str(),
+            model.breakawayPwm,
+            model.coulombPwm,
+            model.viscousPwm,
+            model.stribeckVelocity,
+            model.backlash);
+
+        message += calibration.first + " calibrated\n";
+    }
+
+    std_srvs::Trigger::Request request;
+    std_srvs::Trigger::Response reloaded;
+    reload(request, reloaded);
+
+    publishCalibration(false, success && reloaded.success, message + reloaded.message);
+}
+
+void hardware::publishCalibration(bool calibrating, bool success, const string& message)
+{
+    CalibrationStatus status;
+    status.calibrating = calibrating;
+    status.success = success;
+    status.message = message;
+
+    m_calibrationPub.publish(status);
+}
+
+bool hardware::reload(std_srvs::Trigger::Request& request, std_srvs::Trigger::Response& response)
+{
+    lock_guard<mutex> lock(m_reloadLock);
+
+    XmlRpc::XmlRpcValue settings;
+
+    if (!ros::param::get(m_namespace, settings))
+    {
+        response.success = false;
+        response.message = "no settings found in " + m_namespace;
+        return true;
+    }
+
+    // Controller paths are absolute, settings are relative to namespace
+    string prefix = m_namespace[0] == '/' ? m_namespace : "/" + m_namespace;
+
+    // Validate everything before handing anything over
+    for (auto controller: m_controllers)
+    {
+        XmlRpc::XmlRpcValue controllerSettings;
+        string path = controller->getPath().substr(prefix.length());
+
+        if (!controllerUtilities::getSubtree(settings, path, controllerSettings))
+        {
+            response.success = false;
+            response.message = controller->getPath() + " was removed, restart required";
+            return true;
+        }
+
+        if (!controller->stage(controllerSettings))
+        {
+            response.success = false;
+            response.message = controller->getPath() + " settings are invalid";
+            return true;
+        }
+    }
+
+    // Update loop picks these up at the start of the next cycle
+    for (auto controller: m_controllers)
+        controller->release();
+
+    response.success = true;
+    response.message = "reloaded " + to_string(m_controllers.size()) + " controllers";
+
+    ROS_INFO("%s", response.message.c_str());
+
+    return true;
+}
+
+void hardware::telemetry(const Adc::ConstPtr& msg)
+{
+    recorder::write(recorder::ADC, *msg);
+    receive(*msg, ros::Time::now());
+}
+
+void hardware::receive(const Adc& msg, ros::Time time)
+{
+    m_lastTelemetry = time.toNSec();
+    m_deviceMissed = msg.missed;
+    m_deviceTimeouts = msg.timeouts;
+
+    // Device echoes the correlation ID of the last traced request it applied
+    uint32_t traceId = m_tracePending.load(memory_order_acquire);
+
+    if (traceId && msg.trace == traceId &&
+        m_tracePending.compare_exchange_strong(traceId, 0))
+    {
+        uint64_t received = trace::now();
+        uint64_t sent = m_traceSent.load(memory_order_relaxed);
+
+        // Only the spinner thread that cleared the pending ID updates the estimate
+        double roundTrip = double(received - min(sent, received)) / 1e6;
+        double delay = m_transportDelay.load(memory_order_relaxed);
+
+        m_transportDelay.store(
+            delay > 0.0 ? delay + (roundTrip - delay) * DELAY_SMOOTHING : roundTrip,
+            memory_order_relaxed);
+
+        if (traceId & PROBE_FLAG) return;
+
+        trace::span("deviceEcho", traceId, sent, received);
+        trace::span("deviceDelay", traceId, received - min<uint64_t>(msg.trace_delay, received), received);
+    }
+}
+
+void hardware::read(ros::Duration period)
+{
+    for (auto& group : m_groups)
+    {
+        // Prefer measured velocity over commanded velocity
+        bool measured = false;
+
+        // Encoder sampled for the observer, if any
+        encoder* sampled = NULL;
+
+        for (auto& controller: group.second)
         {
             if (controller->getType() == solenoid::TYPE)
             {
@@ -206,92 +720,568 @@ void hardware::read()
             {
                 encoder* enc = dynamic_cast<encoder*>(controller.get());
 
-                if (enc->isReady()) m_pos[group.first] = enc->getPos();
+                if (enc->isReady())
+                {
+                    m_pos[group.first] = enc->getPos();
+                    sampled = enc;
+                }
+
+                if (enc->isReady() && enc->hasVelocity())
+                {
+                    m_vel[group.first] = enc->getVelocity();
+                    measured = true;
+                }
             }
-            else if (controller->getType() == motor::TYPE)
+            else if (controller->getType() == motor::TYPE && !measured)
             {
                 motor* mtr = dynamic_cast<motor*>(controller.get());
                 m_vel[group.first] = mtr->getVelocity();
             }
+            else if (controller->getType() == currentSensor::TYPE)
+            {
+                currentSensor* sensor = dynamic_cast<currentSensor*>(controller.get());
+
+                // Current sense is unsigned, take the sign of the commanded direction of drive
+                if (sensor->isReady())
+                {
+                    m_effort[group.first] = m_cmd[group.first] >= 0.0
+                        ? sensor->getEffort()
+                        : -sensor->getEffort();
+                }
+            }
+        }
+
+        observer* obs = getObserver(group.first);
+
+        m_measured[group.first] = measured;
+
+        if (!obs || !obs->isEnabled()) continue;
+
+        // Estimate state between samples from the last command
+        obs->predict(period);
+
+        uint32_t samples = sampled ? sampled->getSamples() : 0;
+
+        if (sampled && obs->isNewSample(samples))
+            obs->correct(sampled->getPos(), samples);
+
+        if (obs->isReady())
+        {
+            m_pos[group.first] = obs->getPos();
+            m_vel[group.first] = obs->getVelocity();
+            m_measured[group.first] = true;
         }
     }
 }
 
-void hardware::write()
+void hardware::write(ros::Time time, ros::Duration period)
 {
-    for (auto group : m_groups)
+    uint32_t traceId = trace::getContext();
+    TRACE_SPAN("write", traceId);
+
+    // Commands sent this cycle carry the probe when nothing is traced
+    uint32_t probeId = traceId ? 0 : probe();
+
+    if (probeId)
     {
-        for (auto controller: group.second)
+        traceId = probeId;
+        trace::setContext(probeId);
+    }
+
+    // Await echo of the first command sent for each traced request
+    if (traceId && traceId != m_traceLast)
+    {
+        m_traceSent.store(trace::now(), memory_order_relaxed);
+        m_tracePending.store(traceId, memory_order_release);
+    }
+
+    m_traceLast = traceId;
+
+    // Calibration drives actuators directly instead of controllers
+    if (updateCalibration(time))
+    {
+        if (probeId) trace::setContext(0);
+        return;
+    }
+
+    int index = 0;
+
+    for (auto& group : m_groups)
+    {
+        for (auto& controller: group.second)
         {
             if (controller->getType() == solenoid::TYPE && m_cmd[group.first] > 0.0)
             {
+                double command = m_cmd[group.first];
                 m_cmd[group.first] = 0.0;
 
+                // Strike events carry their offset into the cycle
                 solenoid* sol = dynamic_cast<solenoid*>(controller.get());
-                sol->trigger();
+                sol->trigger(utilities::isStrike(command) ? utilities::decodeStrike(command) : 0.0);
             }
             else if (controller->getType() == motor::TYPE)
             {
                 motor* mtr = dynamic_cast<motor*>(controller.get());
-                mtr->command(m_cmd[group.first]);
+                currentSensor* sensor = getCurrentSensor(group.first);
+
+                observer* obs = getObserver(group.first);
+
+                double command = sensor
+                    ? sensor->limit(m_cmd[group.first], m_pos[group.first], time)
+                    : m_cmd[group.first];
+
+                // Cancel estimated load while driving, never start a stopped joint
+                if (obs && !utilities::isZero(command))
+                    command += obs->getFeedforward();
+
+                if (obs) obs->setCommand(command);
+
+                // Compensation only trusts measured motion, treat the rest as stopped
+                mtr->feedback(m_measured[group.first] ? m_vel[group.first] : 0.0, period.toSec());
+                mtr->command(command, m_feedforward.empty() ? 0.0 : m_feedforward[index]);
             }
         }
+
+        index++;
+    }
+
+    if (probeId) trace::setContext(0);
+}
+
+bool hardware::updateCalibration(ros::Time time)
+{
+    if (!m_calibrating.load(memory_order_acquire)) return false;
+
+    if (m_calibrationAbort.load(memory_order_relaxed))
+    {
+        stopCalibration();
+        stop();
+        return true;
+    }
+
+    bool done = true;
+
+    for (auto& group : m_groups)
+    {
+        motor* mtr = getMotor(group.first);
+        if (!mtr) continue;
+
+        auto calibration = m_calibrations.find(group.first);
+
+        if (calibration == m_calibrations.end() || calibration->second.isDone())
+        {
+            // Joints not calibrating hold still
+            mtr->command(0.0);
+            continue;
+        }
+
+        mtr->drive(calibration->second.update(
+            time.toSec(),
+            m_pos[group.first],
+            m_measured[group.first] ? m_vel[group.first] : 0.0));
+
+        done = done && calibration->second.isDone();
     }
+
+    if (done)
+    {
+        stop();
+        m_calibrating.store(false, memory_order_release);
+    }
+
+    return true;
+}
+
+void hardware::stopCalibration()
+{
+    if (!m_calibrating.load(memory_order_acquire)) return;
+
+    for (auto& calibration : m_calibrations)
+        calibration.second.abort();
+
+    m_calibrating.store(false, memory_order_release);
+}
+
+void hardware::updateFeedforward(ros::Duration period)
+{
+    if (m_feedforward.empty()) return;
+
+    double dt = period.toSec();
+    int index = 0;
+
+    for (auto& group : m_groups)
+    {
+        double command = m_cmd[group.first];
+
+        m_dynamicsPos[index] = m_pos[group.first];
+        m_dynamicsVel[index] = m_vel[group.first];
+
+        // Acceleration requested by the change in velocity command
+        m_dynamicsAccel[index] = dt > 0.0 ? (command - m_dynamicsCmd[index]) / dt : 0.0;
+        m_dynamicsCmd[index] = command;
+
+        index++;
+    }
+
+    if (m_inverseDynamics)
+        m_dynamics.compute(m_dynamicsPos, m_dynamicsVel, m_dynamicsAccel, m_feedforward);
+    else
+        m_dynamics.gravity(m_dynamicsPos, m_feedforward);
+}
+
+uint32_t hardware::probe()
+{
+    // Only motors that change their command carry the probe, a lost probe is replaced
+    if (trace::now() - m_traceSent.load(memory_order_relaxed) < PROBE_INTERVAL)
+        return 0;
+
+    m_probeId = PROBE_FLAG | (m_probeId + 1);
+
+    return m_probeId;
+}
+
+currentSensor* hardware::getCurrentSensor(const string& group)
+{
+    for (auto& controller: m_groups[group])
+    {
+        if (controller->getType() == currentSensor::TYPE)
+            return dynamic_cast<currentSensor*>(controller.get());
+    }
+
+    return NULL;
+}
+
+observer* hardware::getObserver(const string& group)
+{
+    for (auto& controller: m_groups[group])
+    {
+        if (controller->getType() == observer::TYPE)
+            return dynamic_cast<observer*>(controller.get());
+    }
+
+    return NULL;
+}
+
+motor* hardware::getMotor(const string& group)
+{
+    for (auto& controller: m_groups[group])
+    {
+        if (controller->getType() == motor::TYPE)
+            return dynamic_cast<motor*>(controller.get());
+    }
+
+    return NULL;
+}
+
+bool hardware::hasVelocitySource(const string& group)
+{
+    for (auto& controller: m_groups[group])
+    {
+        if (controller->getType() == encoder::TYPE &&
+            dynamic_cast<encoder*>(controller.get())->hasQuadrature())
+            return true;
+
+        if (controller->getType() == observer::TYPE && controller->isEnabled())
+            return true;
+    }
+
+    return false;
+}
+
+solenoid* hardware::getSolenoid(const string& group)
+{
+    for (auto& controller: m_groups[group])
+    {
+        if (controller->getType() == solenoid::TYPE)
+            return dynamic_cast<solenoid*>(controller.get());
+    }
+
+    return NULL;
 }
 
 void hardware::debug()
 {
-    for (auto group : m_groups)
+    for (auto& group : m_groups)
     {
         auto pos = m_pos[group.first];
         auto vel = m_vel[group.first];
         auto cmd = m_cmd[group.first];
         auto eff = m_effort[group.first];
         
-        ROS_INFO_NAMED(
+        ASYNC_INFO_NAMED(
             "hardware",
             "%s: pos %g vel %g eff %g cmd %g",
             group.first.c_str(), pos, vel, eff, cmd);
     }
 }
 
-void hardware::run()
+void hardware::run(bool spin)
 {
     ros::Rate rate(m_rate);
     ros::AsyncSpinner spinner(3);
 
     // Controller manager will deadlock with non-async spinner
-    spinner.start();
+    if (spin) spinner.start();
+    startRecording();
 
-    while(m_node.ok())
+    while(m_node.ok() && m_running)
     {
-        update();
-        rate.sleep();
+        update(ros::Time::now());
+
+        if (!rate.sleep()) m_status.missed_deadlines++;
+    }
+
+    stopRecording();
+
+    if (!m_traceFile.empty())
+    {
+        trace::disable();
+
+        if (trace::save(m_traceFile))
+            ROS_INFO("saved trace to %s, %lu spans dropped", m_traceFile.c_str(), (unsigned long)trace::getDropped());
+        else
+            ROS_ERROR("failed to save trace to %s", m_traceFile.c_str());
     }
 }
 
-/*----------------------------------------------------------*\
-| Node entry point implementation
-\*----------------------------------------------------------*/
+void hardware::shutdown()
+{
+    m_running = false;
+}
+
+bool hardware::replay(const string& path)
+{
+    recordReader log;
+
+    if (!log.open(path))
+    {
+        ROS_ERROR("failed to open recording %s", path.c_str());
+        return false;
+    }
+
+    // Record the replayed session next to the original to compare PWM requests
+    if (m_recordFile.empty() || m_recordFile == path) m_recordFile = path + ".replay";
+
+    startRecording();
+    m_replaying = true;
+
+    // No spinner runs, so readings only arrive from the recording
+    Adc::Ptr readings(new Adc());
+    recorder::recordType type;
+    int64_t stamp;
+    const uint8_t* payload;
+    uint32_t size;
+    size_t cycles = 0;
+    size_t frames = 0;
+    bool result = true;
+
+    while (m_node.ok() && log.next(type, stamp, payload, size))
+    {
+        if (type == recorder::ADC)
+        {
+            if (!recordReader::read(payload, size, *readings))
+            {
+                ROS_ERROR("corrupted readings in %s", path.c_str());
+                result = false;
+                break;
+            }
+
+            feed(readings, log.getTime(stamp));
+            frames++;
+        }
+        else if (type == recorder::CYCLE)
+        {
+            if (size != m_cycleRecord.size())
+            {
+                ROS_ERROR("%s was recorded with different joints", path.c_str());
+                result = false;
+                break;
+            }
+
+            // Restore cycle time and commands written by controller manager
+            int64_t time;
+            memcpy(&time, payload, sizeof(time));
+            payload += sizeof(time);
+
+            for (auto& cmd: m_cmd)
+            {
+                memcpy(&cmd.second, payload, sizeof(double));
+                payload += sizeof(double);
+            }
+
+            ros::Time cycleTime;
+            cycleTime.fromNSec(uint64_t(time));
+
+            update(cycleTime);
+            cycles++;
+        }
+    }
+
+    m_replaying = false;
+    stopRecording();
+
+    ROS_INFO("replayed %lu cycles and %lu readings from %s",
+        (unsigned long)cycles, (unsigned long)frames, path.c_str());
+
+    return comparePwm(path, m_recordFile) && result;
+}
+
+void hardware::feed(const Adc::ConstPtr& msg, ros::Time time)
+{
+    for (auto controller: m_controllers)
+    {
+        if (controller->getType() == encoder::TYPE)
+            dynamic_cast<encoder*>(controller.get())->feedback(msg);
+        else if (controller->getType() == currentSensor::TYPE)
+            dynamic_cast<currentSensor*>(controller.get())->feedback(msg);
+    }
+
+    receive(*msg, time);
+}
+
+void hardware::startRecording()
+{
+    if (m_recordFile.empty()) return;
+
+    if (recorder::open(m_recordFile, size_t(m_recordSize) << 20))
+        ROS_INFO("recording device I/O to %s", m_recordFile.c_str());
+    else
+        ROS_ERROR("failed to open %s for recording", m_recordFile.c_str());
+}
 
-int main(int argc, char** argv)
+void hardware::stopRecording()
 {
-    ros::init(argc, argv, "hardware");
+    if (!recorder::isEnabled()) return;
 
-    ros::NodeHandle node;
-    hardware hw(node, "robot");
+    size_t size = recorder::getSize();
+    uint64_t dropped = recorder::getDropped();
 
-    ROS_INFO("loading hardware");
+    if (!recorder::close())
+        ROS_WARN("failed to trim unused space in %s", m_recordFile.c_str());
 
-    if (!hw.configure() || !hw.init())
+    ROS_INFO("recorded %lu bytes to %s, %lu records dropped",
+        (unsigned long)size, m_recordFile.c_str(), (unsigned long)dropped);
+}
+
+bool hardware::comparePwm(const string& recorded, const string& replayed)
+{
+    recordReader original;
+    recordReader replay;
+
+    if (!original.open(recorded) || !replay.open(replayed))
+    {
+        ROS_ERROR("failed to open %s to compare with %s", replayed.c_str(), recorded.c_str());
+        return false;
+    }
+
+    Pwm expected;
+    Pwm actual;
+    size_t compared = 0;
+    size_t mismatched = 0;
+
+    while (true)
+    {
+        bool hasExpected = original.next(recorder::PWM, expected);
+        bool hasActual = replay.next(recorder::PWM, actual);
+
+        if (!hasExpected && !hasActual) break;
+
+        if (hasExpected != hasActual)
+        {
+            ROS_ERROR("%s has %s PWM requests than %s after %lu",
+                replayed.c_str(), hasActual ? "more" : "fewer", recorded.c_str(), (unsigned long)compared);
+
+            return false;
+        }
+
+        // Trace IDs differ between sessions, only compare what the device is asked to do
+        bool same = expected.channels.size() == actual.channels.size();
+
+        for (size_t index = 0; same && index < expected.channels.size(); index++)
+        {
+            const PwmChannel& a = expected.channels[index];
+            const PwmChannel& b = actual.channels[index];
+
+            same = a.channel == b.channel && a.mode == b.mode && a.value == b.value &&
+                a.duration == b.duration && a.delay == b.delay;
+        }
+
+        if (!same && !mismatched++)
+            ROS_ERROR("replayed PWM request %lu differs from recording", (unsigned long)compared);
+
+        compared++;
+    }
+
+    if (mismatched)
+    {
+        ROS_ERROR("%lu of %lu replayed PWM requests differ from %s",
+            (unsigned long)mismatched, (unsigned long)compared, recorded.c_str());
+
+        return false;
+    }
+
+    ROS_INFO("%lu replayed PWM requests match %s", (unsigned long)compared, recorded.c_str());
+
+    return true;
+}
+
+void hardware::startProfiling()
+{
+    // Counters measure the thread that opened them
+    if (!m_profiler.open())
+    {
+        ROS_WARN("profiling disabled, no performance counters available");
+        m_profile = false;
+        return;
+    }
+
+    for (int counter = 0; counter < profiler::COUNTERS; counter++)
+    {
+        if (!m_profiler.isAvailable(profiler::counter_t(counter)))
+        {
+            ROS_WARN("profiling without %s, counter not available",
+                profiler::getCounterName(profiler::counter_t(counter)));
+        }
+    }
+
+    // Size once, updates only copy counts
+    m_status.profile.resize(profiler::PHASES);
+
+    for (int phase = 0; phase < profiler::PHASES; phase++)
+        m_status.profile[phase].name = profiler::getPhaseName(profiler::phase_t(phase));
+}
+
+void hardware::updateProfile()
+{
+    for (int phase = 0; phase < profiler::PHASES; phase++)
     {
-        ROS_FATAL("hardware failed to initialize");
-        return 1;
+        const profiler::totals_t& totals = m_profiler.getTotals(profiler::phase_t(phase));
+        ProfilePhase& status = m_status.profile[phase];
+
+        status.samples = totals.samples;
+        status.time = totals.time;
+        status.cycles = totals.counters[profiler::CYCLES];
+        status.instructions = totals.counters[profiler::INSTRUCTIONS];
+        status.cache_misses = totals.counters[profiler::CACHE_MISSES];
+        status.context_switches = totals.counters[profiler::CONTEXT_SWITCHES];
     }
+}
+
+void hardware::recordCycle(ros::Time time)
+{
+    if (!recorder::isEnabled()) return;
 
-    ROS_INFO("hardware initialized successfully");
+    int64_t stamp = time.toNSec();
+    uint8_t* pos = m_cycleRecord.data();
 
-    hw.run();
+    memcpy(pos, &stamp, sizeof(stamp));
+    pos += sizeof(stamp);
+
+    for (auto& cmd: m_cmd)
+    {
+        memcpy(pos, &cmd.second, sizeof(double));
+        pos += sizeof(double);
+    }
 
-    return 0;
+    recorder::write(recorder::CYCLE, m_cycleRecord.data(), m_cycleRecord.size());
 }
@@ -22,8 +22,11 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <atomic>
+#include <mutex>
 
 #include <ros/ros.h>
+#include <std_srvs/Trigger.h>
 #include <controller_manager/controller_manager.h>
 #include <hardware_interface/joint_state_interface.h>
 #include <hardware_interface/joint_command_interface.h>
@@ -33,11 +36,21 @@
 #include <joint_limits_interface/joint_limits_rosparam.h>
 #include <joint_limits_interface/joint_limits_urdf.h>
 #include <urdf/model.h>
+#include <realtime_tools/realtime_publisher.h>
 
 #include "controllerFactory.h"
 #include "motor.h"
 #include "encoder.h"
 #include "solenoid.h"
+#include "currentSensor.h"
+#include "observer.h"
+#include "inverseDynamics.h"
+#include "frictionCalibration.h"
+#include "profiler.h"
+#include <str1ker/Adc.h>
+#include <str1ker/Pwm.h>
+#include <str1ker/HardwareStatus.h>
+#include <str1ker/CalibrationStatus.h>
 
 /*----------------------------------------------------------*\
 | Namespace
@@ -55,6 +68,30 @@ private:
     // Default update rate 50 Hz
     const double DEFAULT_RATE = 50;
 
+    // Default time without readings before stopping controllers
+    const double DEFAULT_TELEMETRY_TIMEOUT = 0.25;
+
+    // Publish queue size
+    const int QUEUE_SIZE = 8;
+
+    // Default space reserved for recording in megabytes
+    const int DEFAULT_RECORD_SIZE = 256;
+
+    // Correlation IDs with this bit set probe transport delay and are never traced
+    static const uint32_t PROBE_FLAG = 0x80000000;
+
+    // Time between transport delay probes in trace clock microseconds
+    const uint64_t PROBE_INTERVAL = 250000;
+
+    // Weight of the newest round trip in the transport delay estimate
+    const double DELAY_SMOOTHING = 0.1;
+
+    // Default time allowed for friction calibration in seconds
+    const double DEFAULT_CALIBRATION_TIMEOUT = 120.0;
+
+    // Time between checks for friction calibration to end in seconds
+    const double CALIBRATION_POLL_PERIOD = 0.1;
+
 private:
     // The namespace for loading settings
     std::string m_namespace;
@@ -65,6 +102,15 @@ private:
     // Update rate
     double m_rate;
 
+    // Topic with device readings to monitor
+    std::string m_telemetryTopic;
+
+    // Topic for device heartbeat
+    std::string m_heartbeatTopic;
+
+    // Time without readings before stopping controllers
+    double m_telemetryTimeout;
+
     // ROS controller manager
     controller_manager::ControllerManager m_controllerManager;
 
@@ -75,10 +121,28 @@ private:
     // Hardware state
     std::map<std::string, double> m_pos;
     std::map<std::string, double> m_vel;
+    std::map<std::string, bool> m_measured;
     std::map<std::string, double> m_effort;
     std::map<std::string, joint_limits_interface::JointLimits> m_limits;
+    std::map<std::string, double> m_deceleration;
     std::map<std::string, double> m_cmd;
 
+    // Add efforts holding joints against gravity to motor commands
+    bool m_gravityCompensation;
+
+    // Add efforts for commanded accelerations and velocities as well
+    bool m_inverseDynamics;
+
+    // Rigid body model of the joints for effort feedforward
+    inverseDynamics m_dynamics;
+
+    // Joint state and efforts in group order, allocated once
+    std::vector<double> m_dynamicsPos;
+    std::vector<double> m_dynamicsVel;
+    std::vector<double> m_dynamicsAccel;
+    std::vector<double> m_dynamicsCmd;
+    std::vector<double> m_feedforward;
+
     // Hardware interfaces
     hardware_interface::JointStateInterface m_stateInterface;
     hardware_interface::VelocityJointInterface m_velInterface;
@@ -87,9 +151,115 @@ private:
     // Last update time
     ros::Time m_lastUpdate;
 
+    // First watchdog check, readings are expected within the timeout of it
+    ros::Time m_firstUpdate;
+
+    // Device readings subscriber
+    ros::Subscriber m_telemetrySub;
+
+    // Device heartbeat publisher
+    ros::Publisher m_heartbeatPub;
+
+    // Empty request published as heartbeat
+    Pwm::ConstPtr m_heartbeat;
+
+    // Status counters publisher, serializes on its own thread
+    std::shared_ptr<realtime_tools::RealtimePublisher<HardwareStatus>> m_statusPub;
+
+    // Status counters
+    HardwareStatus m_status;
+
+    // Time of last device readings in nanoseconds, updated by spinner threads
+    std::atomic<uint64_t> m_lastTelemetry;
+
+    // Device counters from last readings, updated by spinner threads
+    std::atomic<uint32_t> m_deviceMissed;
+    std::atomic<uint32_t> m_deviceTimeouts;
+
+    // Whether controllers need a restart after a fault
+    bool m_reset;
+
+    // Settings reload service
+    ros::ServiceServer m_reloadService;
+
+    // Serializes reload requests, never taken by the update loop
+    std::mutex m_reloadLock;
+
+    // Friction calibration service
+    ros::ServiceServer m_calibrateService;
+
+    // Friction calibration progress and outcome, latched
+    ros::Publisher m_calibrationPub;
+
+    // Checks for friction calibration to end without blocking the service
+    ros::WallTimer m_calibrationTimer;
+
+    // Serializes calibration requests and results, never taken by the update loop
+    std::mutex m_calibrationLock;
+
+    // Whether a calibration started and its results were not applied yet
+    bool m_calibrationPending;
+
+    // Time after which calibration is aborted
+    ros::WallTime m_calibrationDeadline;
+
+    // Friction calibration of actuators that enable it, owned by the update loop while calibrating
+    std::map<std::string, frictionCalibration> m_calibrations;
+
+    // Friction calibration settings
+    frictionCalibration::settings_t m_calibrationSettings;
+
+    // Time allowed for friction calibration
+    double m_calibrationTimeout;
+
+    // Set by calibration request, cleared by the update loop once every calibration ended
+    std::atomic<bool> m_calibrating;
+
+    // Set to end calibration early
+    std::atomic<bool> m_calibrationAbort;
+
     // Debugging enabled
     bool m_debug;
 
+    // Chrome trace file written on shutdown, tracing disabled if empty
+    std::string m_traceFile;
+
+    // Last correlation ID written, owned by the update loop
+    uint32_t m_traceLast;
+
+    // Correlation ID sent to the device and awaiting echo in readings
+    std::atomic<uint32_t> m_tracePending;
+
+    // Time the pending correlation ID was sent in trace clock microseconds
+    std::atomic<uint64_t> m_traceSent;
+
+    // Last transport delay probe ID, owned by the update loop
+    uint32_t m_probeId;
+
+    // Smoothed round trip from sending a command to readings that reflect it in seconds
+    std::atomic<double> m_transportDelay;
+
+    // Binary log of device I/O, recording disabled if empty
+    std::string m_recordFile;
+
+    // Space reserved for recording in megabytes
+    int m_recordSize;
+
+    // Cycle record buffer: time followed by joint commands
+    std::vector<uint8_t> m_cycleRecord;
+
+    // Whether commands come from a recording instead of controller manager
+    bool m_replaying;
+
+    // Whether to read performance counters around update phases
+    bool m_profile;
+
+    // Performance counters for update phases, opened on the update thread
+    profiler m_profiler;
+
+    // Cleared to stop the real-time loop
+    std::atomic<bool> m_running;
+
 public:
     // Constructor
     hardware(ros::NodeHandle node, std::string configNamespace);
@@ -102,26 +272,128 @@ public:
     bool init();
 
     // Update joints
-    void update();
+    void update(ros::Time time);
+
+    // Run real-time loop, spin callbacks unless a nodelet manager does
+    void run(bool spin = true);
+
+    // Stop real-time loop from another thread
+    void shutdown();
+
+    // Feed recorded device I/O through controllers as fast as possible
+    bool replay(const std::string& path);
+
+    // Deliver readings to controllers directly instead of through topics
+    void feed(const Adc::ConstPtr& msg, ros::Time time);
 
-    // Run real-time loop
-    void run();
+    // Get update rate
+    inline double getRate() const
+    {
+        return m_rate;
+    }
+
+    // Get hardware controllers
+    inline const controllerArray& getControllers() const
+    {
+        return m_controllers;
+    }
+
+    // Get joint limits loaded from robot description
+    inline const joint_limits_interface::JointLimits& getLimits(const std::string& joint)
+    {
+        return m_limits[joint];
+    }
+
+    // Get controller manager running high-level controllers
+    inline controller_manager::ControllerManager& getControllerManager()
+    {
+        return m_controllerManager;
+    }
 
 private:
     // Read hardware state
-    void read();
+    void read(ros::Duration period);
+
+    // Cap commanded velocity so joints can stop at their position limits
+    void enforcePositionLimits(ros::Duration period);
 
     // Send queued commands to hardware
-    void write();
+    void write(ros::Time time, ros::Duration period);
+
+    // Compute effort feedforward for queued commands
+    void updateFeedforward(ros::Duration period);
+
+    // Start a transport delay probe if none was sent recently, returns probe ID or 0
+    uint32_t probe();
+
+    // Check for missing readings and device timeouts, returns true if faulted
+    bool watchdog(ros::Time time);
+
+    // Stop all actuators
+    void stop();
+
+    // Determine deceleration available for braking before position limits
+    void updateDeceleration(motor* mtr);
+
+    // Re-read settings and hand them to controllers without restarting
+    bool reload(std_srvs::Trigger::Request& request, std_srvs::Trigger::Response& response);
+
+    // Start identifying friction and backlash of actuators that enable calibration
+    bool calibrate(std_srvs::Trigger::Request& request, std_srvs::Trigger::Response& response);
+
+    // Apply identified parameters and reload once calibration ended
+    void calibrationTimer(const ros::WallTimerEvent& event);
+
+    // Publish friction calibration progress or outcome
+    void publishCalibration(bool calibrating, bool success, const std::string& message);
+
+    // Drive actuators for friction calibration, returns false if not calibrating
+    bool updateCalibration(ros::Time time);
+
+    // End friction calibration from the update loop
+    void stopCalibration();
+
+    // Device readings feedback
+    void telemetry(const Adc::ConstPtr& msg);
+
+    // Track device counters and trace echo from readings
+    void receive(const Adc& msg, ros::Time time);
+
+    // Start recording device I/O if enabled
+    void startRecording();
+
+    // Stop recording device I/O
+    void stopRecording();
+
+    // Compare PWM requests in two recordings, returns false if they differ
+    bool comparePwm(const std::string& recorded, const std::string& replayed);
+
+    // Record cycle time and joint commands
+    void recordCycle(ros::Time time);
+
+    // Open performance counters on the update thread
+    void startProfiling();
+
+    // Copy performance counters to status
+    void updateProfile();
+
+    // Find current sensor for a joint, if any
+    currentSensor* getCurrentSensor(const std::string& group);
+
+    // Find disturbance observer for a joint, if any
+    observer* getObserver(const std::string& group);
+
+    // Find motor for a joint, if any
+    motor* getMotor(const std::string& group);
+
+    // Whether a joint has velocity measured by quadrature or an enabled observer
+    bool hasVelocitySource(const std::string& group);
+
+    // Find solenoid for a joint, if any
+    solenoid* getSolenoid(const std::string& group);
 
     // Output velocity and state for each joint
     void debug();
 };
 
 } // namespace str1ker
-
-/*----------------------------------------------------------*\
-| Node entry point
-\*----------------------------------------------------------*/
-
-int main(int argc, char** argv);
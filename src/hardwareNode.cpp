@@ -0,0 +1,67 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ hardwareNode.cpp
+
+ Hardware Interface Node
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include "hardware.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Node entry point implementation
+\*----------------------------------------------------------*/
+
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "hardware");
+
+    // Replay recorded device I/O instead of running against the device
+    string replayFile;
+
+    for (int arg = 1; arg < argc - 1; arg++)
+    {
+        if (string(argv[arg]) == "--replay") replayFile = argv[arg + 1];
+    }
+
+    // Replayed PWM requests, status and services go under a separate namespace to stay off the device
+    ros::NodeHandle node(replayFile.empty() ? "" : "replay");
+    hardware hw(node, "robot");
+
+    ROS_INFO("loading hardware");
+
+    if (!hw.configure() || !hw.init())
+    {
+        ROS_FATAL("hardware failed to initialize");
+        return 1;
+    }
+
+    ROS_INFO("hardware initialized successfully");
+
+    if (!replayFile.empty())
+        return hw.replay(replayFile) ? 0 : 1;
+
+    hw.run();
+
+    return 0;
+}
@@ -86,4 +86,26 @@ inline bool isSameSign(double a, double b)
   return (a >= 0.0) == (b >= 0.0);
 }
 
+/*----------------------------------------------------------*\
+| Strike events
+\*----------------------------------------------------------*/
+
+// Solenoid commands from this value up carry a strike delayed by the excess in seconds
+const double STRIKE_COMMAND = 1000.0;
+
+inline double encodeStrike(double delay)
+{
+  return STRIKE_COMMAND + (delay > 0.0 ? delay : 0.0);
+}
+
+inline bool isStrike(double command)
+{
+  return command >= STRIKE_COMMAND;
+}
+
+inline double decodeStrike(double command)
+{
+  return command - STRIKE_COMMAND;
+}
+
 } // namespace str1ker
\ No newline at end of file
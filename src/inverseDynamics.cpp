@@ -0,0 +1,253 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ inverseDynamics.cpp
+
+ Inverse Dynamics Solver
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <algorithm>
+#include "inverseDynamics.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace std;
+using namespace Eigen;
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| inverseDynamics implementation
+\*----------------------------------------------------------*/
+
+//
+// Initialization
+//
+
+bool inverseDynamics::init(const urdf::Model& model, const vector<string>& joints)
+{
+  m_joints = joints;
+  m_links.clear();
+
+  urdf::LinkConstSharedPtr root = model.getRoot();
+  if (!root) return false;
+
+  // Root link is fixed to the world and carries no load
+  addChildren(root, -1);
+
+  m_state.resize(m_links.size());
+
+  return !m_links.empty();
+}
+
+void inverseDynamics::addChildren(urdf::LinkConstSharedPtr link, int parent)
+{
+  for (const urdf::LinkSharedPtr& child : link->child_links)
+  {
+    const urdf::JointSharedPtr& joint = child->parent_joint;
+    const urdf::Pose& pose = joint->parent_to_joint_origin_transform;
+
+    link_t body;
+    body.parent = parent;
+    body.joint = -1;
+    body.multiplier = 1.0;
+    body.offset = 0.0;
+    body.prismatic = joint->type == urdf::Joint::PRISMATIC;
+
+    double x, y, z, w;
+    pose.rotation.getQuaternion(x, y, z, w);
+
+    body.originRotation = Quaterniond(w, x, y, z).toRotationMatrix();
+    body.originPosition = Vector3d(pose.position.x, pose.position.y, pose.position.z);
+    body.axis = Vector3d(joint->axis.x, joint->axis.y, joint->axis.z);
+
+    if (body.axis.norm() > 0.0) body.axis.normalize();
+
+    if (joint->type == urdf::Joint::REVOLUTE ||
+        joint->type == urdf::Joint::CONTINUOUS ||
+        joint->type == urdf::Joint::PRISMATIC)
+    {
+      // Linkages are described by mimic joints that follow an actuated joint
+      string name = joint->mimic ? joint->mimic->joint_name : joint->name;
+      auto found = find(m_joints.begin(), m_joints.end(), name);
+
+      if (found != m_joints.end())
+      {
+        body.joint = int(found - m_joints.begin());
+
+        if (joint->mimic)
+        {
+          body.multiplier = joint->mimic->multiplier;
+          body.offset = joint->mimic->offset;
+        }
+      }
+
+      // Joints that are not actuated are held at zero
+    }
+
+    if (child->inertial)
+    {
+      const urdf::Inertial& inertial = *child->inertial;
+
+      inertial.origin.rotation.getQuaternion(x, y, z, w);
+      Matrix3d principal = Quaterniond(w, x, y, z).toRotationMatrix();
+
+      Matrix3d inertia;
+      inertia <<
+        inertial.ixx, inertial.ixy, inertial.ixz,
+        inertial.ixy, inertial.iyy, inertial.iyz,
+        inertial.ixz, inertial.iyz, inertial.izz;
+
+      body.mass = inertial.mass;
+      body.com = Vector3d(inertial.origin.position.x, inertial.origin.position.y, inertial.origin.position.z);
+      body.inertia = principal * inertia * principal.transpose();
+    }
+    else
+    {
+      body.mass = 0.0;
+      body.com = Vector3d::Zero();
+      body.inertia = Matrix3d::Zero();
+    }
+
+    m_links.push_back(body);
+
+    addChildren(child, int(m_links.size()) - 1);
+  }
+}
+
+//
+// Dynamics
+//
+
+void inverseDynamics::gravity(const vector<double>& position, vector<double>& effort)
+{
+  solve(position, nullptr, nullptr, effort);
+}
+
+void inverseDynamics::compute(
+  const vector<double>& position,
+  const vector<double>& velocity,
+  const vector<double>& acceleration,
+  vector<double>& effort)
+{
+  solve(position, &velocity, &acceleration, effort);
+}
+
+void inverseDynamics::solve(
+  const vector<double>& position,
+  const vector<double>* velocity,
+  const vector<double>* acceleration,
+  vector<double>& effort)
+{
+  effort.resize(m_joints.size());
+  fill(effort.begin(), effort.end(), 0.0);
+
+  // Accelerating the root upward loads every link the same way gravity does
+  const Vector3d rootAccel(0.0, 0.0, GRAVITY);
+
+  // Forward pass: link motion from root to tips
+  for (size_t index = 0; index < m_links.size(); index++)
+  {
+    const link_t& link = m_links[index];
+    state_t& state = m_state[index];
+
+    double q = 0.0, qd = 0.0, qdd = 0.0;
+
+    if (link.joint >= 0)
+    {
+      q = link.multiplier * position[link.joint] + link.offset;
+      if (velocity) qd = link.multiplier * (*velocity)[link.joint];
+      if (acceleration) qdd = link.multiplier * (*acceleration)[link.joint];
+    }
+
+    state.rotation = link.originRotation;
+    state.position = link.originPosition;
+
+    if (link.joint >= 0 && link.prismatic)
+      state.position += link.originRotation * (link.axis * q);
+    else if (link.joint >= 0)
+      state.rotation *= AngleAxisd(q, link.axis).toRotationMatrix();
+
+    Vector3d parentOmega = Vector3d::Zero();
+    Vector3d parentAlpha = Vector3d::Zero();
+    Vector3d parentAccel = rootAccel;
+
+    if (link.parent >= 0)
+    {
+      const state_t& parent = m_state[link.parent];
+      parentOmega = parent.omega;
+      parentAlpha = parent.alpha;
+      parentAccel = parent.accel;
+    }
+
+    Matrix3d toLink = state.rotation.transpose();
+
+    state.omega = toLink * parentOmega;
+    state.alpha = toLink * parentAlpha;
+    state.accel = toLink * (
+      parentAccel +
+      parentAlpha.cross(state.position) +
+      parentOmega.cross(parentOmega.cross(state.position)));
+
+    if (link.joint >= 0 && link.prismatic)
+    {
+      // Coriolis and sliding acceleration along the axis
+      state.accel += 2.0 * state.omega.cross(qd * link.axis) + qdd * link.axis;
+    }
+    else if (link.joint >= 0)
+    {
+      state.alpha += state.omega.cross(qd * link.axis) + qdd * link.axis;
+      state.omega += qd * link.axis;
+    }
+
+    // Force and moment about link origin needed to produce this motion
+    Vector3d comAccel =
+      state.accel +
+      state.alpha.cross(link.com) +
+      state.omega.cross(state.omega.cross(link.com));
+
+    state.force = link.mass * comAccel;
+    state.moment =
+      link.inertia * state.alpha +
+      state.omega.cross(link.inertia * state.omega) +
+      link.com.cross(state.force);
+  }
+
+  // Backward pass: loads from tips to root, children always follow parents
+  for (int index = int(m_links.size()) - 1; index >= 0; index--)
+  {
+    const link_t& link = m_links[index];
+    const state_t& state = m_state[index];
+
+    // Effort on a mimic joint reaches its actuator through the linkage ratio
+    if (link.joint >= 0)
+    {
+      effort[link.joint] += link.multiplier * (link.prismatic
+        ? state.force.dot(link.axis)
+        : state.moment.dot(link.axis));
+    }
+
+    if (link.parent >= 0)
+    {
+      state_t& parent = m_state[link.parent];
+      Vector3d force = state.rotation * state.force;
+
+      parent.force += force;
+      parent.moment += state.rotation * state.moment + state.position.cross(force);
+    }
+  }
+}
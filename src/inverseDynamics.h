@@ -0,0 +1,139 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ inverseDynamics.h
+
+ Inverse Dynamics Solver
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <string>
+#include <vector>
+#include <Eigen/Geometry>
+#include <urdf/model.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| inverseDynamics class
+\*----------------------------------------------------------*/
+
+class inverseDynamics
+{
+private:
+  // Standard gravity
+  const double GRAVITY = 9.80665;
+
+  // Rigid body attached to its parent by a URDF joint
+  struct link_t
+  {
+    // Parent link index, -1 for links attached to the root
+    int parent;
+
+    // Actuated joint index driving this link, -1 if fixed
+    int joint;
+
+    // Mapping from actuated joint variable, mimic joints follow linkages
+    double multiplier;
+    double offset;
+
+    // Whether joint translates along its axis instead of rotating
+    bool prismatic;
+
+    // Joint origin in parent link frame, kept unaligned for storage in vectors
+    Eigen::Matrix3d originRotation;
+    Eigen::Vector3d originPosition;
+
+    // Joint axis in link frame
+    Eigen::Vector3d axis;
+
+    // Mass, center of mass and inertia about the center of mass in link frame
+    double mass;
+    Eigen::Vector3d com;
+    Eigen::Matrix3d inertia;
+  };
+
+  // Per cycle state of a link, allocated once
+  struct state_t
+  {
+    // Link rotation and origin in parent frame
+    Eigen::Matrix3d rotation;
+    Eigen::Vector3d position;
+
+    // Angular velocity and acceleration, linear acceleration of origin in link frame
+    Eigen::Vector3d omega;
+    Eigen::Vector3d alpha;
+    Eigen::Vector3d accel;
+
+    // Force and moment exerted on link by its parent in link frame
+    Eigen::Vector3d force;
+    Eigen::Vector3d moment;
+  };
+
+private:
+  // Links ordered so that parents come before children
+  std::vector<link_t> m_links;
+
+  // Link state, same order as links
+  std::vector<state_t> m_state;
+
+  // Actuated joint names
+  std::vector<std::string> m_joints;
+
+public:
+  // Build rigid body tree from robot description for actuated joints
+  bool init(const urdf::Model& model, const std::vector<std::string>& joints);
+
+  // Get actuated joint names, in the order of positions and efforts
+  inline const std::vector<std::string>& getJoints() const
+  {
+    return m_joints;
+  }
+
+  // Get number of rigid bodies
+  inline int getLinkCount() const
+  {
+    return (int)m_links.size();
+  }
+
+  // Compute efforts holding actuated joints against gravity
+  void gravity(const std::vector<double>& position, std::vector<double>& effort);
+
+  // Compute efforts producing accelerations with recursive Newton-Euler
+  void compute(
+    const std::vector<double>& position,
+    const std::vector<double>& velocity,
+    const std::vector<double>& acceleration,
+    std::vector<double>& effort);
+
+private:
+  // Add child links of a link in depth first order
+  void addChildren(urdf::LinkConstSharedPtr link, int parent);
+
+  // Run both passes, velocity and acceleration may be null
+  void solve(
+    const std::vector<double>& position,
+    const std::vector<double>* velocity,
+    const std::vector<double>* acceleration,
+    std::vector<double>& effort);
+};
+
+} // namespace str1ker
@@ -25,6 +25,7 @@
 #include <eigen_conversions/eigen_msg.h>
 #include <tf2_eigen/tf2_eigen.h>
 #include "inverseKinematicsSolver.h"
+#include "asyncLog.h"
 #include "inverseKinematicsPlugin.h"
 
 /*----------------------------------------------------------*\
@@ -498,7 +499,7 @@ Matrix4d IKPlugin::getGoal(const std::vector<geometry_msgs::Pose>& ik_poses, con
     goalMatrix(1, 3) = goalMatrix(1, 3) - origin.y();
     goalMatrix(2, 3) = goalMatrix(2, 3) - origin.z();
 
-    ROS_DEBUG_NAMED(
+    ASYNC_DEBUG_NAMED(
         PLUGIN_NAME,
         "IK goal %s [\n\t%g, %g, %g, %g;\n\t%g, %g, %g, %g;\n\t%g, %g, %g, %g;\n\t%g, %g, %g, %g\n]",
         tip_frames_.front().c_str(),
@@ -534,7 +535,7 @@ Vector3d IKPlugin::getGoalPosition(const vector<geometry_msgs::Pose>& ik_poses,
     pos.y() = pos.y() - origin.y();
     pos.z() = pos.z() - origin.z();
 
-    ROS_DEBUG_NAMED(
+    ASYNC_DEBUG_NAMED(
         PLUGIN_NAME,
         "IK goal %s: %g, %g, %g",
         tip_frames_.front().c_str(),
@@ -565,7 +566,7 @@ bool IKPlugin::validateSeedState(const vector<double>& ik_seed_state) const
         return false;
     }
 
-    ROS_DEBUG_NAMED(
+    ASYNC_DEBUG_NAMED(
         PLUGIN_NAME,
         "Received seed state for %ld joints",
         ik_seed_state.size()
@@ -575,7 +576,7 @@ bool IKPlugin::validateSeedState(const vector<double>& ik_seed_state) const
         jointIndex < ik_seed_state.size();
         jointIndex++)
     {
-        ROS_DEBUG_NAMED(
+        ASYNC_DEBUG_NAMED(
             PLUGIN_NAME,
             "\t%s (%s): %g",
             m_joints[jointIndex]->getName().c_str(),
@@ -648,7 +649,7 @@ Isometry3d IKPlugin::setJointState(
     size_t index = find(m_joints.begin(), m_joints.end(), pJoint) - m_joints.begin();
     states[index] = jointState;
 
-    ROS_DEBUG_NAMED(PLUGIN_NAME, "IK solution %s: %g [%g] min %g max %g",
+    ASYNC_DEBUG_NAMED(PLUGIN_NAME, "IK solution %s: %g [%g] min %g max %g",
         pJoint->getName().c_str(), angle, jointState, limits.min_position,
         limits.max_position);
 
@@ -19,14 +19,20 @@
 | Includes
 \*----------------------------------------------------------*/
 
+#include <algorithm>
+#include <limits>
+#include <type_traits>
 #include <urdf/model.h>
 #include <joint_limits_interface/joint_limits.h>
 #include <joint_limits_interface/joint_limits_urdf.h>
 #include <pluginlib/class_list_macros.h>
 
 #include "jointTrajectoryController.h"
+#include "mpcTrajectoryController.h"
 #include "hardwareUtilities.h"
 #include "controllerUtilities.h"
+#include "asyncLog.h"
+#include "trace.h"
 
 /*----------------------------------------------------------*\
 | Namespace
@@ -36,11 +42,12 @@ using namespace std;
 using namespace str1ker;
 
 /*----------------------------------------------------------*\
-| jointTrajectoryController implementation
+| trajectoryController implementation
 \*----------------------------------------------------------*/
 
-bool jointTrajectoryController::init(
-    hardware_interface::VelocityJointInterface* hw,
+template <class hardwareInterface>
+bool trajectoryController<hardwareInterface>::init(
+    hardwareInterface* hw,
     ros::NodeHandle& managerNode,
     ros::NodeHandle& node)
 {
@@ -56,6 +63,42 @@ bool jointTrajectoryController::init(
     ROS_INFO_NAMED(m_name.c_str(), "Trajectory debugging enabled");
   }
 
+  // Load delay compensation settings
+  node.getParam("delay_compensation/enable", m_delayCompensation);
+  node.getParam("delay_compensation/delay", m_delay);
+  node.getParam("delay_compensation/extra_delay", m_extraDelay);
+
+  // Smith predictor models the response to velocity commands
+  if (m_delayCompensation && !is_same<hardwareInterface, velocityHardware>::value)
+  {
+    ROS_WARN_NAMED(m_name.c_str(), "Delay compensation needs a velocity interface, disabled");
+    m_delayCompensation = false;
+  }
+
+  // Load feedforward flag
+  node.getParam("feedforward", m_feedforward);
+
+  if (m_delayCompensation)
+  {
+    string statusTopic = "/hardware_status";
+    node.getParam("delay_compensation/status_topic", statusTopic);
+
+    // Transport delay is measured by hardware unless a fixed delay is given
+    if (m_delay <= 0.0)
+    {
+      m_statusSub = m_node.subscribe(
+        statusTopic, 1, &trajectoryController::hardwareStatusCallback, this
+      );
+    }
+
+    ROS_INFO_NAMED(
+      m_name.c_str(),
+      "Delay compensation enabled, %s delay plus %g seconds",
+      m_delay > 0.0 ? "fixed" : statusTopic.c_str(),
+      m_extraDelay
+    );
+  }
+
   // Load joint names
   vector<string> jointNames;
 
@@ -130,6 +173,9 @@ bool jointTrajectoryController::init(
     joint.maxVelocity = limits.has_velocity_limits
       ? limits.max_velocity
       : 1.0;
+    joint.maxEffort = limits.has_effort_limits
+      ? limits.max_effort
+      : numeric_limits<double>::max();
 
     if (!node.getParam(string("constraints/") + jointName + "/goal", joint.tolerance))
     {
@@ -176,25 +222,101 @@ bool jointTrajectoryController::init(
       joint.pid.initPid(DEFAULT_P, DEFAULT_I, DEFAULT_D, 1.0, 0.0);
     }
 
+    if (loadSchedule(node, joint))
+    {
+      ROS_INFO_NAMED(
+        m_name.c_str(),
+        "Scheduled gains for %s: %d positions up, %d down, transfer %g seconds",
+        jointName.c_str(),
+        (int)joint.scheduleUp.size(),
+        (int)joint.scheduleDown.size(),
+        joint.transferTime
+      );
+    }
+
+    if (!node.getParam(string("delay_compensation/") + jointName + "/time_constant", joint.timeConstant))
+    {
+      if (m_delayCompensation)
+      {
+        ROS_INFO_NAMED(
+          m_name.c_str(),
+          "No delay compensation time constant for %s, default %g seconds",
+          jointName.c_str(),
+          DEFAULT_TIME_CONSTANT
+        );
+      }
+
+      // Use default velocity response time of the plant model
+      joint.timeConstant = DEFAULT_TIME_CONSTANT;
+    }
+
+    // Allocate prediction history once, the update loop only overwrites it
+    joint.history.resize(HISTORY_SIZE);
+
     // Loaded joint successfully
+    m_jointIndexes[jointName] = m_joints.size();
     m_joints.push_back(joint);
   }
 
+  // Load strike joint, fired as discrete events instead of tracked
+  if (node.getParam("strike_joint", m_strikeJoint))
+  {
+    if (m_jointIndexes.count(m_strikeJoint))
+    {
+      ROS_ERROR_NAMED(m_name.c_str(), "Strike joint %s cannot also be a tracked joint", m_strikeJoint.c_str());
+      return false;
+    }
+
+    m_strike = m_hardware->getHandle(m_strikeJoint);
+
+    ROS_INFO_NAMED(m_name.c_str(), "Strike events fired on %s", m_strikeJoint.c_str());
+  }
+
   // Subscribe to trajectory goals
   m_goalSub = m_node.subscribe(
-    "command", 1, &jointTrajectoryController::trajectoryGoalCallback, this
+    "command", 1, &trajectoryController::trajectoryGoalCallback, this
   );
 
-  // Publish state
-  m_statePub = m_node.advertise<control_msgs::JointTrajectoryControllerState>(
-    "state", 1
+  // Publish state and feedback from the update loop without blocking or allocating
+  m_pStatePub.reset(
+    new realtime_tools::RealtimePublisher<control_msgs::JointTrajectoryControllerState>(
+      m_node, "state", 1
+    )
   );
 
-  // Publish trajectory feedback
-  m_feedbackPub = m_node.advertise<control_msgs::FollowJointTrajectoryFeedback>(
-    "feedback", 1
+  m_pFeedbackPub.reset(
+    new realtime_tools::RealtimePublisher<control_msgs::FollowJointTrajectoryFeedback>(
+      m_node, "feedback", 1
+    )
   );
 
+  // Size messages once so the update loop only overwrites values
+  control_msgs::JointTrajectoryControllerState& state = m_pStatePub->msg_;
+  control_msgs::FollowJointTrajectoryFeedback& feedback = m_pFeedbackPub->msg_;
+
+  for (trajectory_msgs::JointTrajectoryPoint* point : {
+    &state.actual, &state.desired, &state.error,
+    &feedback.actual, &feedback.desired, &feedback.error })
+  {
+    point->positions.resize(m_joints.size());
+    point->velocities.resize(m_joints.size());
+  }
+
+  for (const joint_t& joint : m_joints)
+  {
+    state.joint_names.push_back(joint.name);
+    feedback.joint_names.push_back(joint.name);
+  }
+
+  m_position.resize(m_joints.size());
+  m_ahead.resize(m_joints.size());
+  m_ahead2.resize(m_joints.size());
+  m_referenceVel.resize(m_joints.size());
+  m_referenceAccel.resize(m_joints.size());
+  m_effort.resize(m_joints.size());
+
+  if (!initCommands(model)) return false;
+
   // Publish trajectory result
   m_resultPub = m_node.advertise<control_msgs::FollowJointTrajectoryResult>(
     "result", 1
@@ -204,8 +326,8 @@ bool jointTrajectoryController::init(
   m_pGoalServer.reset(new actionlib::ActionServer<control_msgs::FollowJointTrajectoryAction>(
     m_node,
     "follow_joint_trajectory",
-    bind(&jointTrajectoryController::trajectoryActionCallback, this, placeholders::_1),
-    bind(&jointTrajectoryController::trajectoryCancelCallback, this, placeholders::_1),
+    bind(&trajectoryController::trajectoryActionCallback, this, placeholders::_1),
+    bind(&trajectoryController::trajectoryCancelCallback, this, placeholders::_1),
     false
   ));
 
@@ -214,7 +336,7 @@ bool jointTrajectoryController::init(
   // Advertise trajectory state service
   m_stateService = m_node.advertiseService(
     "query_state",
-    &jointTrajectoryController::trajectoryQueryCallback,
+    &trajectoryController::trajectoryQueryCallback,
     this
   );
 
@@ -226,102 +348,118 @@ bool jointTrajectoryController::init(
   return true;
 }
 
-void jointTrajectoryController::starting(const ros::Time& time)
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::starting(const ros::Time& time)
 {
+  holdCommands();
 }
 
-void jointTrajectoryController::stopping(const ros::Time&)
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::stopping(const ros::Time&)
 {
   endTrajectory();
 }
 
-void jointTrajectoryController::update(const ros::Time& time, const ros::Duration& period)
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::update(const ros::Time& time, const ros::Duration& period)
+{
+  updateTrajectory(*this, time, period);
+}
+
+template <class hardwareInterface>
+template <class commandLaw>
+void trajectoryController<hardwareInterface>::updateTrajectory(
+  commandLaw& law, const ros::Time& time, const ros::Duration& period)
 {
+  // Start the latest goal parsed by callback threads, swapping buffers without allocating
+  if (m_pending.take(m_received))
+  {
+    beginTrajectory(m_received);
+  }
+
+  // Cancel requests are applied here so the trajectory is never ended mid-update
+  if (m_cancel.exchange(false, memory_order_acq_rel) && m_state == trajectoryState::EXECUTING)
+  {
+    endTrajectory();
+  }
+
   if (m_state == trajectoryState::EXECUTING)
   {
-    runTrajectory(time, period);
+    runTrajectory(law, time, period);
   }
 }
 
-void jointTrajectoryController::trajectoryFeedback(const ros::Time& time, double trajectoryTime)
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::trajectoryFeedback(const ros::Time& time, double trajectoryTime)
 {
-  control_msgs::JointTrajectoryControllerState trajectoryState;
-  control_msgs::FollowJointTrajectoryFeedback trajectoryFeedback;
-
   uint32_t seq = m_seq++;
 
-  trajectoryState.header.stamp = time;
-  trajectoryState.header.seq = seq;
-  trajectoryState.joint_names.resize(m_joints.size());
-
-  trajectoryFeedback.header.stamp = time;
-  trajectoryFeedback.header.seq = seq;
-  trajectoryFeedback.joint_names.resize(m_joints.size());
-
-  trajectoryState.actual.time_from_start = ros::Duration(trajectoryTime);
-  trajectoryState.actual.positions.resize(m_joints.size());
-  trajectoryState.actual.velocities.resize(m_joints.size());
+  // Skip the state message this cycle if the publisher thread is still sending the last one
+  if (m_pStatePub->trylock())
+  {
+    control_msgs::JointTrajectoryControllerState& trajectoryState = m_pStatePub->msg_;
 
-  trajectoryState.desired.time_from_start = ros::Duration(trajectoryTime);
-  trajectoryState.desired.positions.resize(m_joints.size());
-  trajectoryState.desired.velocities.resize(m_joints.size());
+    trajectoryState.header.stamp = time;
+    trajectoryState.header.seq = seq;
+    trajectoryState.actual.time_from_start = ros::Duration(trajectoryTime);
+    trajectoryState.desired.time_from_start = ros::Duration(trajectoryTime);
+    trajectoryState.error.time_from_start = ros::Duration(trajectoryTime);
 
-  trajectoryState.error.time_from_start = ros::Duration(trajectoryTime);
-  trajectoryState.error.positions.resize(m_joints.size());
-  trajectoryState.error.velocities.resize(m_joints.size());
+    for (int jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+    {
+      trajectoryState.actual.positions[jointIndex] = m_joints[jointIndex].pos;
+      trajectoryState.actual.velocities[jointIndex] = m_joints[jointIndex].vel;
 
-  trajectoryFeedback.actual.time_from_start = ros::Duration(trajectoryTime);
-  trajectoryFeedback.actual.positions.resize(m_joints.size());
-  trajectoryFeedback.actual.velocities.resize(m_joints.size());
+      trajectoryState.desired.positions[jointIndex] = m_joints[jointIndex].goal;
+      trajectoryState.desired.velocities[jointIndex] = m_joints[jointIndex].vel;
 
-  trajectoryFeedback.desired.time_from_start = ros::Duration(trajectoryTime);
-  trajectoryFeedback.desired.positions.resize(m_joints.size());
-  trajectoryFeedback.desired.velocities.resize(m_joints.size());
+      trajectoryState.error.positions[jointIndex] = m_joints[jointIndex].error;
+      trajectoryState.error.velocities[jointIndex] = 0.0;
+    }
 
-  trajectoryFeedback.error.time_from_start = ros::Duration(trajectoryTime);
-  trajectoryFeedback.error.positions.resize(m_joints.size());
-  trajectoryFeedback.error.velocities.resize(m_joints.size());
+    m_pStatePub->unlockAndPublish();
+  }
 
-  for (int jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+  if (m_pFeedbackPub->trylock())
   {
-    trajectoryState.joint_names[jointIndex] = m_joints[jointIndex].name;
-
-    trajectoryState.actual.positions[jointIndex] = m_joints[jointIndex].pos;
-    trajectoryState.actual.velocities[jointIndex] = m_joints[jointIndex].vel;
+    control_msgs::FollowJointTrajectoryFeedback& trajectoryFeedback = m_pFeedbackPub->msg_;
 
-    trajectoryState.desired.positions[jointIndex] = m_joints[jointIndex].goal;
-    trajectoryState.desired.velocities[jointIndex] = m_joints[jointIndex].vel;
+    trajectoryFeedback.header.stamp = time;
+    trajectoryFeedback.header.seq = seq;
+    trajectoryFeedback.actual.time_from_start = ros::Duration(trajectoryTime);
+    trajectoryFeedback.desired.time_from_start = ros::Duration(trajectoryTime);
+    trajectoryFeedback.error.time_from_start = ros::Duration(trajectoryTime);
 
-    trajectoryState.error.positions[jointIndex] = m_joints[jointIndex].error;
-    trajectoryState.error.velocities[jointIndex] = 0.0;
-
-    trajectoryFeedback.joint_names[jointIndex] = m_joints[jointIndex].name;
-
-    trajectoryFeedback.actual.positions[jointIndex] = m_joints[jointIndex].pos;
-    trajectoryFeedback.actual.velocities[jointIndex] = m_joints[jointIndex].vel;
+    for (int jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+    {
+      trajectoryFeedback.actual.positions[jointIndex] = m_joints[jointIndex].pos;
+      trajectoryFeedback.actual.velocities[jointIndex] = m_joints[jointIndex].vel;
 
-    trajectoryFeedback.desired.positions[jointIndex] = m_joints[jointIndex].goal;
-    trajectoryFeedback.desired.velocities[jointIndex] = m_joints[jointIndex].vel;
+      trajectoryFeedback.desired.positions[jointIndex] = m_joints[jointIndex].goal;
+      trajectoryFeedback.desired.velocities[jointIndex] = m_joints[jointIndex].vel;
 
-    trajectoryFeedback.error.positions[jointIndex] = m_joints[jointIndex].error;
-    trajectoryFeedback.error.velocities[jointIndex] = 0.0;
-  }
+      trajectoryFeedback.error.positions[jointIndex] = m_joints[jointIndex].error;
+      trajectoryFeedback.error.velocities[jointIndex] = 0.0;
+    }
 
-  m_statePub.publish(trajectoryState);
-  m_feedbackPub.publish(trajectoryFeedback);
+    // Action feedback is serialized on this thread by actionlib, only when a goal is active
+    if (m_goal.isValid())
+    {
+      m_goal.publishFeedback(trajectoryFeedback);
+    }
 
-  if (m_goal.isValid())
-  {
-    m_goal.publishFeedback(trajectoryFeedback);
+    m_pFeedbackPub->unlockAndPublish();
   }
 }
 
-void jointTrajectoryController::trajectoryGoalCallback(const trajectory_msgs::JointTrajectory::ConstPtr& msg)
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::trajectoryGoalCallback(const trajectory_msgs::JointTrajectory::ConstPtr& msg)
 {
-  parseTrajectory(*msg);
+  parseTrajectory(*msg, ros::Time::now());
 }
 
-void jointTrajectoryController::trajectoryActionCallback(
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::trajectoryActionCallback(
   actionlib::ActionServer<control_msgs::FollowJointTrajectoryAction>::GoalHandle goal)
 {
   if (!this->isRunning())
@@ -333,18 +471,31 @@ void jointTrajectoryController::trajectoryActionCallback(
     return;
   }
 
-  parseTrajectory(goal.getGoal()->trajectory);
-  goal.setAccepted();
-  m_goal = goal;
+  int32_t error = parseTrajectory(goal.getGoal()->trajectory, ros::Time::now(), goal);
+
+  if (error != control_msgs::FollowJointTrajectoryResult::SUCCESSFUL)
+  {
+    control_msgs::FollowJointTrajectoryResult result;
+    result.error_code = error;
+    goal.setRejected(result);
+  }
 }
 
-void jointTrajectoryController::trajectoryCancelCallback(
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::trajectoryCancelCallback(
   actionlib::ActionServer<control_msgs::FollowJointTrajectoryAction>::GoalHandle goal)
 {
-  endTrajectory();
+  lock_guard<mutex> lock(m_parseLock);
+
+  // Ignore cancel requests for goals that were already replaced
+  if (m_latest && m_latest->goal == goal)
+  {
+    m_cancel.store(true, memory_order_release);
+  }
 }
 
-bool jointTrajectoryController::trajectoryQueryCallback(
+template <class hardwareInterface>
+bool trajectoryController<hardwareInterface>::trajectoryQueryCallback(
   control_msgs::QueryTrajectoryState::Request& req,
   control_msgs::QueryTrajectoryState::Response& res)
 {
@@ -359,40 +510,65 @@ bool jointTrajectoryController::trajectoryQueryCallback(
   res.velocity.resize(m_joints.size());
   res.acceleration.resize(m_joints.size());
 
+  // Sample the latest accepted goal, the executing buffer belongs to the update loop
   vector<double> position;
-  auto waypoint = sampleTrajectory(req.time.toSec(), position);
-  if (!waypoint) return false;
+  vector<double> velocity(m_joints.size(), 0.0);
+  vector<double> acceleration(m_joints.size(), 0.0);
+
+  typename trajectory_t::ConstPtr latest;
+
+  {
+    lock_guard<mutex> lock(m_parseLock);
+    latest = m_latest;
+  }
+
+  if (!latest || sampleTrajectory(*latest, req.time.toSec(), position) < 0) return false;
+  sampleDerivatives(*latest, req.time.toSec(), velocity, acceleration);
 
   for (int jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
   {
     res.name[jointIndex] = m_joints[jointIndex].name;
     res.position[jointIndex] = position[jointIndex];
-    res.velocity[jointIndex] = 0.0;
-    res.acceleration[jointIndex] = 0.0;
+    res.velocity[jointIndex] = velocity[jointIndex];
+    res.acceleration[jointIndex] = acceleration[jointIndex];
   }
 
   return true;
 }
 
-void jointTrajectoryController::parseTrajectory(const trajectory_msgs::JointTrajectory& trajectory)
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::hardwareStatusCallback(const HardwareStatus::ConstPtr& msg)
+{
+  m_transportDelay.store(msg->transport_delay, memory_order_relaxed);
+}
+
+template <class hardwareInterface>
+int32_t trajectoryController<hardwareInterface>::parseTrajectory(
+  const trajectory_msgs::JointTrajectory& trajectory,
+  const ros::Time& time,
+  trajectoryActionServer::GoalHandle goal)
 {
+  // Correlate spans from goal to device readings
+  uint32_t traceId = trace::begin();
+  TRACE_SPAN("parseTrajectory", traceId);
+
   // Parse trajectory message joints
   vector<int> jointIndexes;
+  int strikeJointIndex = -1;
 
-  for (auto jointName : trajectory.joint_names)
+  for (const string& jointName : trajectory.joint_names)
   {
-    int foundJointIndex = -1;
-
-    for (int jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+    // Strike joint positions mark events instead of a path to track
+    if (!m_strikeJoint.empty() && jointName == m_strikeJoint)
     {
-      if (m_joints[jointIndex].name == jointName)
-      {
-        foundJointIndex = jointIndex;
-        break;
-      }
+      strikeJointIndex = jointIndexes.size();
+      jointIndexes.push_back(-1);
+      continue;
     }
 
-    if (foundJointIndex == -1)
+    auto foundJoint = m_jointIndexes.find(jointName);
+
+    if (foundJoint == m_jointIndexes.end())
     {
       // Do not support joints that are not available
       ROS_ERROR_NAMED(
@@ -400,58 +576,142 @@ void jointTrajectoryController::parseTrajectory(const trajectory_msgs::JointTraj
         "Found joint %s in trajectory not claimed by this controller, aborting",
         jointName.c_str());
 
-      return;
+      return control_msgs::FollowJointTrajectoryResult::INVALID_JOINTS;
     }
 
-    jointIndexes.push_back(foundJointIndex);
+    jointIndexes.push_back(foundJoint->second);
   }
 
-  // Parse trajectory message waypoints
-  vector<waypoint_t> waypoints;
+  // Every waypoint needs a position for each joint, and velocities and accelerations for all or none
+  size_t names = jointIndexes.size();
+  bool derivatives = !trajectory.points.empty();
+
+  for (int waypointIndex = 0; waypointIndex < trajectory.points.size(); waypointIndex++)
+  {
+    const trajectory_msgs::JointTrajectoryPoint& sourceWaypoint = trajectory.points[waypointIndex];
+    size_t velocities = sourceWaypoint.velocities.size();
+    size_t accelerations = sourceWaypoint.accelerations.size();
+
+    if (sourceWaypoint.positions.size() != names ||
+      (velocities && velocities != names) ||
+      (accelerations && accelerations != names))
+    {
+      ROS_ERROR_NAMED(
+        m_name.c_str(),
+        "Waypoint %d has %d positions, %d velocities and %d accelerations for %d joints, aborting",
+        waypointIndex,
+        (int)sourceWaypoint.positions.size(),
+        (int)velocities,
+        (int)accelerations,
+        (int)names);
+
+      return control_msgs::FollowJointTrajectoryResult::INVALID_GOAL;
+    }
+
+    // Keep planned velocities and accelerations when every waypoint has both
+    derivatives = derivatives && velocities && accelerations;
+  }
+
+  // Parse trajectory message waypoints into rows of a new buffer owned by this thread
+  size_t joints = m_joints.size();
+  size_t stride = 1 + joints * (derivatives ? 3 : 1);
+  size_t rows = 0;
   double prevWaypointTime = 0.0;
 
+  bool striking = false;
+
+  shared_ptr<trajectory_t> parsed = make_shared<trajectory_t>();
+  parsed->stride = stride;
+  parsed->joints = joints;
+  parsed->derivatives = derivatives;
+  parsed->points.assign(trajectory.points.size() * stride, 0.0);
+
   for (int waypointIndex = 0; waypointIndex < trajectory.points.size(); waypointIndex++)
   {
     const trajectory_msgs::JointTrajectoryPoint& sourceWaypoint = trajectory.points[waypointIndex];
     double waypointTime = sourceWaypoint.time_from_start.toSec();
 
+    // Strike at the exact time the strike joint position turns positive
+    if (strikeJointIndex != -1)
+    {
+      bool strike = sourceWaypoint.positions[strikeJointIndex] > 0.0;
+      if (strike && !striking) parsed->strikes.push_back(waypointTime);
+      striking = strike;
+    }
+
     if (waypointIndex && waypointTime - prevWaypointTime < DISCRETE_TOLERANCE)
       continue;
 
-    waypoint_t targetWaypoint;
-    targetWaypoint.time = waypointTime;
-    targetWaypoint.position.resize(jointIndexes.size());
+    double* targetWaypoint = &parsed->points[rows++ * stride];
+    targetWaypoint[0] = waypointTime;
 
     for (int sourceJointIndex = 0; sourceJointIndex < jointIndexes.size(); sourceJointIndex++)
     {
       int targetJointIndex = jointIndexes[sourceJointIndex];
-      targetWaypoint.position[targetJointIndex] = sourceWaypoint.positions[sourceJointIndex];
+      if (targetJointIndex == -1) continue;
+
+      targetWaypoint[targetJointIndex + 1] = sourceWaypoint.positions[sourceJointIndex];
+
+      if (derivatives)
+      {
+        targetWaypoint[targetJointIndex + 1 + joints] = sourceWaypoint.velocities[sourceJointIndex];
+        targetWaypoint[targetJointIndex + 1 + joints * 2] = sourceWaypoint.accelerations[sourceJointIndex];
+      }
     }
- 
-    prevWaypointTime = targetWaypoint.time;
 
-    waypoints.push_back(targetWaypoint);
+    prevWaypointTime = waypointTime;
+  }
+
+  // Drop rows of skipped waypoints
+  parsed->points.resize(rows * stride);
+  parsed->points.shrink_to_fit();
+
+  parsed->start = time;
+  parsed->traceId = traceId;
+  parsed->goal = goal;
+
+  if (goal.isValid())
+  {
+    goal.setAccepted();
   }
 
-  // Begin executing parsed trajectory
-  beginTrajectory(ros::Time::now(), waypoints);
+  // Share the parsed buffer with trajectory queries and the update loop. The buffer
+  // handed back holds an older goal and is released here, off the update loop
+  typename trajectory_t::ConstPtr handoff = move(parsed);
+
+  {
+    // Goals may arrive on several callback threads, the update loop never takes this lock
+    lock_guard<mutex> lock(m_parseLock);
+
+    m_latest = handoff;
+    m_cancel.store(false, memory_order_release);
+    m_pending.exchange(handoff);
+  }
+
+  return control_msgs::FollowJointTrajectoryResult::SUCCESSFUL;
 }
 
-void jointTrajectoryController::beginTrajectory(
-  const ros::Time& time, const std::vector<waypoint_t>& waypoints)
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::beginTrajectory(typename trajectory_t::ConstPtr& trajectory)
 {
-  ROS_INFO_NAMED(
+  ASYNC_INFO_NAMED(
     m_name.c_str(),
-    "Starting trajectory with %d waypoints",
-    (int)waypoints.size()
+    "Starting trajectory with %d waypoints and %d strikes",
+    (int)trajectory->size(),
+    (int)trajectory->strikes.size()
   );
 
   // Reset controller state
   m_state = trajectoryState::EXECUTING;
-  m_startTime = time;
-  m_lastTime = time;
-  m_trajectory = waypoints;
+  m_startTime = trajectory->start;
+  m_lastTime = trajectory->start;
+
+  // Swap pointers only, the previous buffer goes back through the handoff to be released by callback threads
+  swap(m_trajectory, trajectory);
+  m_goal = m_trajectory->goal;
+  m_nextStrike = 0;
   m_seq = 0;
+  m_traceId = m_trajectory->traceId;
 
   // Reset joint states
   for (joint_t& joint : m_joints)
@@ -462,25 +722,42 @@ void jointTrajectoryController::beginTrajectory(
     joint.command = 0.0;
     joint.completed = false;
 
-    if (!waypoints.empty())
+    resetPrediction(joint, 0.0);
+
+    // Start from gains scheduled for this position without slewing
+    if (!joint.scheduleUp.empty())
+    {
+      joint.gains = interpolateGains(joint.scheduleUp, joint.pos);
+      joint.integral = 0.0;
+      joint.lastError = 0.0;
+      joint.hasLastError = false;
+    }
+
+    if (m_trajectory->size())
     {
-      joint.goal = waypoints.front().position[&joint - &m_joints.front()];
+      joint.goal = m_trajectory->position(0)[&joint - &m_joints.front()];
     }
   }
 }
 
-void jointTrajectoryController::endTrajectory()
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::endTrajectory()
 {
   m_state = trajectoryState::DONE;
 
-  ROS_INFO_NAMED(m_name.c_str(), "Ending trajectory");
+  ASYNC_INFO_NAMED(m_name.c_str(), "Ending trajectory");
+
+  trace::instant("endTrajectory", m_traceId);
+  trace::setContext(0);
 
-  for (auto joint : m_joints)
+  for (joint_t& joint : m_joints)
   {
     joint.pid.reset();
-    joint.handle.setCommand(0.0);
+    joint.integral = 0.0;
   }
 
+  holdCommands();
+
   control_msgs::FollowJointTrajectoryResult result;
   result.error_code = control_msgs::FollowJointTrajectoryResult::SUCCESSFUL;
 
@@ -494,15 +771,22 @@ void jointTrajectoryController::endTrajectory()
   m_resultPub.publish(result);
 }
 
-void jointTrajectoryController::runTrajectory(const ros::Time& time, const ros::Duration& period)
+template <class hardwareInterface>
+template <class commandLaw>
+void trajectoryController<hardwareInterface>::runTrajectory(
+  commandLaw& law, const ros::Time& time, const ros::Duration& period)
 {
-  vector<double> position;
+  // Commands written to hardware this cycle carry the trajectory correlation ID
+  TRACE_SPAN("runTrajectory", m_traceId);
+  trace::setContext(m_traceId);
+
   double trajectoryTime = (time - m_startTime).toSec();
 
-  auto waypoint = sampleTrajectory(trajectoryTime, position);
-  if (!waypoint) return;
+  int waypoint = sampleTrajectory(trajectoryTime, m_position);
+  if (waypoint < 0) return;
 
-  bool isLastWaypoint = waypoint - &m_trajectory.front() == m_trajectory.size() - 1;
+  const double* waypointPosition = m_trajectory->position(waypoint);
+  bool isLastWaypoint = waypoint == m_trajectory->size() - 1;
 
   // Read joints
   for (joint_t& joint : m_joints)
@@ -512,8 +796,16 @@ void jointTrajectoryController::runTrajectory(const ros::Time& time, const ros::
 
     // Update joint velocity
     joint.vel = ceil(joint.handle.getVelocity() * 100.0) / 100.0;
+
+    // Predict position the last commands will have reached once readings catch up
+    joint.predicted = m_delayCompensation && !joint.completed
+      ? predictPosition(joint, trajectoryTime, period.toSec())
+      : joint.pos;
   }
 
+  // Feedforward for all joints at once, inverse dynamics couples them
+  prepareCommands(trajectoryTime);
+
   // Write joints
   int completed = 0;
 
@@ -527,17 +819,17 @@ void jointTrajectoryController::runTrajectory(const ros::Time& time, const ros::
     }
 
     // Get goal position
-    joint.goal = waypoint->position[&joint - &m_joints.front()];
+    joint.goal = waypointPosition[&joint - &m_joints.front()];
 
     // Calculate position error
     if (joint.type == supportedJointTypes::REVOLUTE)
     {
       angles::shortest_angular_distance_with_large_limits(
-        joint.pos, joint.goal, joint.min, joint.max, joint.error);
+        joint.predicted, joint.goal, joint.min, joint.max, joint.error);
     }
     else if (joint.type == supportedJointTypes::PRISMATIC)
     {
-      joint.error = joint.goal - joint.pos;
+      joint.error = joint.goal - joint.predicted;
     }
 
     // Stop if executed trajectory and ended within goal tolerance
@@ -545,7 +837,7 @@ void jointTrajectoryController::runTrajectory(const ros::Time& time, const ros::
     {
       joint.completed = true;
 
-      ROS_INFO_NAMED(
+      ASYNC_INFO_NAMED(
         m_name.c_str(),
         "Joint %s trajectory completed: position %g within %g of %g, tolerance %g",
         joint.name.c_str(),
@@ -563,7 +855,7 @@ void jointTrajectoryController::runTrajectory(const ros::Time& time, const ros::
     {
       joint.completed = true;
 
-      ROS_INFO_NAMED(
+      ASYNC_INFO_NAMED(
         m_name.c_str(),
         "Joint %s trajectory timeout %g seconds",
         joint.name.c_str(),
@@ -574,32 +866,32 @@ void jointTrajectoryController::runTrajectory(const ros::Time& time, const ros::
     }
 
     // Calculate command
-    joint.command = clamp(
-      joint.pid.computeCommand(joint.error, period),
-      -joint.maxVelocity,
-      joint.maxVelocity
-    );
+    // Bound at compile time, no virtual call per joint
+    double command = law.computeCommand(joint, trajectoryTime, period);
+
+    joint.command = limitCommand(joint, command);
 
     joint.handle.setCommand(joint.command);
   }
 
+  // Strikes are timed by the trajectory, not by tracking
+  fireStrikes(trajectoryTime, period);
+
   // Publish state
   trajectoryFeedback(time, trajectoryTime);
 
   // Emit current state
   if (m_debug)
   {
-    int trajectoryIndex = waypoint - &m_trajectory.front();
-
-    ROS_INFO(
+    ASYNC_INFO(
       "[waypoint %d] time %#.4g",
-      trajectoryIndex,
+      waypoint,
       trajectoryTime
     );
 
     for (const joint_t& joint : m_joints)
     {
-      ROS_INFO(
+      ASYNC_INFO(
         "\t%-24.24spos %#+.3g\tvel %#+.3g\tcmd %#+.3g\t%s goal %#+.3g\terr %#+.3g\t%s",
         joint.name.c_str(),
         joint.pos,
@@ -613,53 +905,516 @@ void jointTrajectoryController::runTrajectory(const ros::Time& time, const ros::
     }
   }
 
-  // End trajectory if all joints reached goal positions or timed out
-  if (completed == m_joints.size())
+  // End trajectory if all joints reached goal positions or timed out and all strikes fired
+  if (completed == m_joints.size() && m_nextStrike >= m_trajectory->strikes.size())
   {
     endTrajectory();
   }
 }
 
-const jointTrajectoryController::waypoint_t* jointTrajectoryController::sampleTrajectory(
-  double timeFromStart, vector<double>& position)
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::fireStrikes(double trajectoryTime, const ros::Duration& period)
 {
-  if (m_trajectory.empty()) return nullptr;
+  if (m_nextStrike >= m_trajectory->strikes.size()) return;
 
-  for (const waypoint_t& waypoint : m_trajectory)
+  // Fire a strike due before the next cycle with its offset into this one
+  double strikeTime = m_trajectory->strikes[m_nextStrike];
+  if (strikeTime >= trajectoryTime + period.toSec()) return;
+
+  double offset = max(strikeTime - trajectoryTime, 0.0);
+
+  m_strike.setCommand(utilities::encodeStrike(offset));
+  m_nextStrike++;
+
+  trace::instant("strike", m_traceId);
+
+  if (m_debug)
   {
-    if (waypoint.time >= timeFromStart)
+    ASYNC_INFO("[strike %d] time %#.4g offset %#.4g", (int)m_nextStrike, strikeTime, offset);
+  }
+}
+
+template <class hardwareInterface>
+bool trajectoryController<hardwareInterface>::loadSchedule(ros::NodeHandle& node, joint_t& joint)
+{
+  string path = "gains/" + joint.name;
+  XmlRpc::XmlRpcValue schedule;
+
+  if (!node.getParam(path + "/schedule", schedule)) return false;
+
+  if (!node.getParam(path + "/transfer_time", joint.transferTime))
+    joint.transferTime = DEFAULT_TRANSFER_TIME;
+
+  if (schedule.getType() != XmlRpc::XmlRpcValue::TypeArray || !schedule.size())
+  {
+    ROS_WARN_NAMED(m_name.c_str(), "Gain schedule for %s is not a list, using fixed gains", joint.name.c_str());
+    return false;
+  }
+
+  for (int index = 0; index < schedule.size(); index++)
+  {
+    XmlRpc::XmlRpcValue& entry = schedule[index];
+    gains_t gains = {0.0, 0.0, 0.0, 0.0};
+    int direction = 0;
+
+    if (!controllerUtilities::getSetting(entry, "position", gains.position) ||
+        !controllerUtilities::getSetting(entry, "p", gains.p))
     {
-      int nextIndex = &waypoint - &m_trajectory.front() + 1;
-      
-      if (nextIndex >= m_trajectory.size())
-      {
-        // Clamp position when out of trajectory bounds
-        position = waypoint.position;
-      }
-      else
-      {
-        // Interpolate position of each joint when between waypoints
-        position.resize(waypoint.position.size());
-
-        for (int jointIndex = 0; jointIndex < waypoint.position.size(); jointIndex++)
-        {
-          double x = timeFromStart;
-          double x1 = waypoint.time;
-          double y1 = waypoint.position[jointIndex];
-          double x2 = m_trajectory[nextIndex].time;
-          double y2 = m_trajectory[nextIndex].position[jointIndex];
-
-          position[jointIndex] = y1 + (x - x1) * ((y2 - y1) / (x2 - x1));
-        }
-      }
+      ROS_WARN_NAMED(
+        m_name.c_str(),
+        "Gain schedule entry %d for %s needs position and p, using fixed gains",
+        index,
+        joint.name.c_str()
+      );
 
-      return &waypoint;
+      joint.scheduleUp.clear();
+      joint.scheduleDown.clear();
+      return false;
     }
+
+    controllerUtilities::getSetting(entry, "i", gains.i);
+    controllerUtilities::getSetting(entry, "d", gains.d);
+    controllerUtilities::getSetting(entry, "direction", direction);
+
+    // Entries without direction apply both ways
+    if (direction >= 0) joint.scheduleUp.push_back(gains);
+    if (direction <= 0) joint.scheduleDown.push_back(gains);
   }
 
-  // Clamp position when out of trajectory bounds
-  position = m_trajectory.back().position;
-  return &m_trajectory.back();
+  // A direction without its own entries uses the other direction
+  if (joint.scheduleUp.empty()) joint.scheduleUp = joint.scheduleDown;
+  if (joint.scheduleDown.empty()) joint.scheduleDown = joint.scheduleUp;
+
+  auto byPosition = [](const gains_t& a, const gains_t& b) { return a.position < b.position; };
+  sort(joint.scheduleUp.begin(), joint.scheduleUp.end(), byPosition);
+  sort(joint.scheduleDown.begin(), joint.scheduleDown.end(), byPosition);
+
+  return true;
+}
+
+template <class hardwareInterface>
+typename trajectoryController<hardwareInterface>::gains_t trajectoryController<hardwareInterface>::interpolateGains(
+  const vector<gains_t>& schedule, double position)
+{
+  if (position <= schedule.front().position) return schedule.front();
+  if (position >= schedule.back().position) return schedule.back();
+
+  for (size_t index = 1; index < schedule.size(); index++)
+  {
+    const gains_t& upper = schedule[index];
+
+    if (position > upper.position) continue;
+
+    const gains_t& lower = schedule[index - 1];
+    double span = upper.position - lower.position;
+    double t = span > 0.0 ? (position - lower.position) / span : 1.0;
+
+    gains_t gains;
+    gains.position = position;
+    gains.p = lower.p + t * (upper.p - lower.p);
+    gains.i = lower.i + t * (upper.i - lower.i);
+    gains.d = lower.d + t * (upper.d - lower.d);
+
+    return gains;
+  }
+
+  return schedule.back();
+}
+
+template <class hardwareInterface>
+double trajectoryController<hardwareInterface>::computeScheduledCommand(joint_t& joint, double period)
+{
+  // No correction without elapsed time, the caller still adds feedforward
+  if (period <= 0.0) return 0.0;
+
+  // Schedule for the direction the joint is being driven
+  const vector<gains_t>& schedule = joint.error >= 0.0
+    ? joint.scheduleUp
+    : joint.scheduleDown;
+
+  gains_t target = interpolateGains(schedule, joint.pos);
+
+  // Slew toward scheduled gains so crossing entries or reversing doesn't bump the command
+  double blend = joint.transferTime > 0.0
+    ? 1.0 - exp(-period / joint.transferTime)
+    : 1.0;
+
+  joint.gains.p += blend * (target.p - joint.gains.p);
+  joint.gains.i += blend * (target.i - joint.gains.i);
+  joint.gains.d += blend * (target.d - joint.gains.d);
+
+  // Integrate gain-weighted error so changing the integral gain never bumps the command
+  control_toolbox::Pid::Gains limits = joint.pid.getGains();
+
+  joint.integral = utilities::clamp(
+    joint.integral + joint.gains.i * joint.error * period,
+    limits.i_min_,
+    limits.i_max_);
+
+  // No derivative on the first cycle, there is no previous error to difference against
+  double derivative = joint.hasLastError
+    ? (joint.error - joint.lastError) / period
+    : 0.0;
+
+  joint.lastError = joint.error;
+  joint.hasLastError = true;
+
+  return joint.gains.p * joint.error + joint.integral + joint.gains.d * derivative;
+}
+
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::resetPrediction(joint_t& joint, double time)
+{
+  // Model starts where the joint is, before any delayed commands
+  joint.modelPos = joint.pos;
+  joint.modelVel = joint.vel;
+  joint.predicted = joint.pos;
+  joint.head = 0;
+  joint.samples = 1;
+  joint.history[0].time = time;
+  joint.history[0].position = joint.pos;
+}
+
+template <class hardwareInterface>
+double trajectoryController<hardwareInterface>::predictPosition(joint_t& joint, double time, double period)
+{
+  if (period > 0.0)
+  {
+    // Advance first order velocity response by the command sent last cycle
+    double tau = joint.timeConstant;
+    double a = exp(-period / tau);
+    double b = tau * (1.0 - a);
+
+    joint.modelPos += b * joint.modelVel + (period - b) * joint.command;
+    joint.modelVel = a * joint.modelVel + (1.0 - a) * joint.command;
+
+    joint.head = (joint.head + 1) % HISTORY_SIZE;
+    joint.samples = min(joint.samples + 1, HISTORY_SIZE);
+    joint.history[joint.head].time = time;
+    joint.history[joint.head].position = joint.modelPos;
+  }
+
+  // Find model position when the current readings were taken
+  double delayedTime = time - getDelay();
+  double delayedPos = joint.history[joint.head].position;
+
+  for (int sample = 1; sample < joint.samples && delayedTime < time; sample++)
+  {
+    const sample_t& newer = joint.history[(joint.head - sample + 1 + HISTORY_SIZE) % HISTORY_SIZE];
+    const sample_t& older = joint.history[(joint.head - sample + HISTORY_SIZE) % HISTORY_SIZE];
+
+    delayedPos = older.position;
+
+    if (older.time <= delayedTime)
+    {
+      // Interpolate between cycles for delays that are not a whole number of periods
+      double span = newer.time - older.time;
+
+      if (span > 0.0)
+        delayedPos += (delayedTime - older.time) / span * (newer.position - older.position);
+
+      break;
+    }
+  }
+
+  // Measured position corrected by model motion not yet visible in readings
+  return joint.pos + joint.modelPos - delayedPos;
+}
+
+template <class hardwareInterface>
+double trajectoryController<hardwareInterface>::getDelay() const
+{
+  double delay = m_delay > 0.0
+    ? m_delay
+    : m_transportDelay.load(memory_order_relaxed);
+
+  return delay + m_extraDelay;
+}
+
+template <class hardwareInterface>
+int trajectoryController<hardwareInterface>::sampleTrajectory(
+  double timeFromStart, vector<double>& position) const
+{
+  if (!m_trajectory) return -1;
+
+  return sampleTrajectory(*m_trajectory, timeFromStart, position);
+}
+
+template <class hardwareInterface>
+int trajectoryController<hardwareInterface>::sampleTrajectory(
+  const trajectory_t& trajectory, double timeFromStart, vector<double>& position)
+{
+  size_t waypoints = trajectory.size();
+  if (!waypoints) return -1;
+
+  size_t joints = trajectory.joints;
+  position.resize(joints);
+
+  size_t index = trajectory.upperBound(timeFromStart);
+
+  if (index == 0 || index >= waypoints)
+  {
+    // Clamp position when out of trajectory bounds
+    size_t clamped = index ? waypoints - 1 : 0;
+    const double* waypoint = trajectory.position(clamped);
+    copy(waypoint, waypoint + joints, position.begin());
+
+    return clamped;
+  }
+
+  // Interpolate position of each joint between the waypoints around the sample time
+  const double* prev = trajectory.position(index - 1);
+  const double* next = trajectory.position(index);
+  double x1 = trajectory.time(index - 1);
+  double x2 = trajectory.time(index);
+  double t = (timeFromStart - x1) / (x2 - x1);
+
+  for (size_t jointIndex = 0; jointIndex < joints; jointIndex++)
+  {
+    position[jointIndex] = prev[jointIndex] + t * (next[jointIndex] - prev[jointIndex]);
+  }
+
+  return index;
+}
+
+template <class hardwareInterface>
+bool trajectoryController<hardwareInterface>::sampleDerivatives(
+  const trajectory_t& trajectory,
+  double timeFromStart,
+  vector<double>& velocity,
+  vector<double>& acceleration)
+{
+  size_t waypoints = trajectory.size();
+  if (!waypoints || !trajectory.derivatives) return false;
+
+  size_t joints = trajectory.joints;
+  velocity.resize(joints);
+  acceleration.resize(joints);
+
+  size_t index = trajectory.upperBound(timeFromStart);
+
+  if (index == 0 || index >= waypoints)
+  {
+    // Clamp planned derivatives when out of trajectory bounds
+    size_t clamped = index ? waypoints - 1 : 0;
+    copy(trajectory.velocity(clamped), trajectory.velocity(clamped) + joints, velocity.begin());
+    copy(trajectory.acceleration(clamped), trajectory.acceleration(clamped) + joints, acceleration.begin());
+
+    return true;
+  }
+
+  // Interpolate planned derivatives between the waypoints around the sample time
+  double x1 = trajectory.time(index - 1);
+  double x2 = trajectory.time(index);
+  double t = (timeFromStart - x1) / (x2 - x1);
+
+  for (size_t jointIndex = 0; jointIndex < joints; jointIndex++)
+  {
+    double v1 = trajectory.velocity(index - 1)[jointIndex];
+    double v2 = trajectory.velocity(index)[jointIndex];
+    double a1 = trajectory.acceleration(index - 1)[jointIndex];
+    double a2 = trajectory.acceleration(index)[jointIndex];
+
+    velocity[jointIndex] = v1 + t * (v2 - v1);
+    acceleration[jointIndex] = a1 + t * (a2 - a1);
+  }
+
+  return true;
+}
+
+template <class hardwareInterface>
+void trajectoryController<hardwareInterface>::sampleReference(double trajectoryTime)
+{
+  // Use planned velocities and accelerations when the goal carries them
+  if (sampleDerivatives(*m_trajectory, trajectoryTime, m_referenceVel, m_referenceAccel)) return;
+
+  // Otherwise differentiate the trajectory ahead of the current setpoint
+  sampleTrajectory(trajectoryTime + FEEDFORWARD_STEP, m_ahead);
+  sampleTrajectory(trajectoryTime + FEEDFORWARD_STEP * 2.0, m_ahead2);
+
+  for (size_t jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+  {
+    double current = m_position[jointIndex];
+    double next = m_ahead[jointIndex];
+    double after = m_ahead2[jointIndex];
+
+    m_referenceVel[jointIndex] = (next - current) / FEEDFORWARD_STEP;
+    m_referenceAccel[jointIndex] = (after - 2.0 * next + current) / (FEEDFORWARD_STEP * FEEDFORWARD_STEP);
+  }
+}
+
+/*----------------------------------------------------------*\
+| Position command law
+\*----------------------------------------------------------*/
+
+template <>
+bool trajectoryController<positionHardware>::initCommands(const urdf::Model& model)
+{
+  return true;
+}
+
+template <>
+void trajectoryController<positionHardware>::prepareCommands(double trajectoryTime)
+{
+}
+
+template <>
+double trajectoryController<positionHardware>::computeCommand(
+  joint_t& joint, double trajectoryTime, const ros::Duration& period)
+{
+  // Hardware closes the position loop, pass interpolated setpoint through
+  return m_position[&joint - &m_joints.front()];
+}
+
+template <>
+double trajectoryController<positionHardware>::limitCommand(const joint_t& joint, double command) const
+{
+  return utilities::clamp(command, joint.min, joint.max);
+}
+
+template <>
+void trajectoryController<positionHardware>::holdCommands()
+{
+  for (joint_t& joint : m_joints)
+    joint.handle.setCommand(joint.handle.getPosition());
+}
+
+/*----------------------------------------------------------*\
+| Velocity command law
+\*----------------------------------------------------------*/
+
+template <>
+bool trajectoryController<velocityHardware>::initCommands(const urdf::Model& model)
+{
+  return true;
+}
+
+template <>
+void trajectoryController<velocityHardware>::prepareCommands(double trajectoryTime)
+{
+  if (!m_feedforward) return;
+
+  sampleReference(trajectoryTime);
+
+  for (size_t jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+    m_joints[jointIndex].feedforward = m_referenceVel[jointIndex];
+}
+
+template <>
+double trajectoryController<velocityHardware>::computeCommand(
+  joint_t& joint, double trajectoryTime, const ros::Duration& period)
+{
+  double correction = joint.scheduleUp.empty()
+    ? joint.pid.computeCommand(joint.error, period)
+    : computeScheduledCommand(joint, period.toSec());
+
+  return correction + joint.feedforward;
+}
+
+template <>
+double trajectoryController<velocityHardware>::limitCommand(const joint_t& joint, double command) const
+{
+  return utilities::clamp(command, -joint.maxVelocity, joint.maxVelocity);
+}
+
+template <>
+void trajectoryController<velocityHardware>::holdCommands()
+{
+  for (joint_t& joint : m_joints)
+    joint.handle.setCommand(0.0);
 }
 
+/*----------------------------------------------------------*\
+| Effort command law
+\*----------------------------------------------------------*/
+
+template <>
+bool trajectoryController<effortHardware>::initCommands(const urdf::Model& model)
+{
+  if (!m_feedforward) return true;
+
+  vector<string> jointNames;
+
+  for (const joint_t& joint : m_joints)
+    jointNames.push_back(joint.name);
+
+  if (!m_dynamics.init(model, jointNames))
+  {
+    ROS_ERROR_NAMED(m_name.c_str(), "No links in robot_description for inverse dynamics feedforward");
+    return false;
+  }
+
+  ROS_INFO_NAMED(
+    m_name.c_str(),
+    "Inverse dynamics feedforward over %d links",
+    m_dynamics.getLinkCount()
+  );
+
+  return true;
+}
+
+template <>
+void trajectoryController<effortHardware>::prepareCommands(double trajectoryTime)
+{
+  if (!m_feedforward) return;
+
+  sampleReference(trajectoryTime);
+
+  // Effort to follow the reference from where the joints are
+  for (size_t jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+    m_ahead[jointIndex] = m_joints[jointIndex].pos;
+
+  m_dynamics.compute(m_ahead, m_referenceVel, m_referenceAccel, m_effort);
+
+  for (size_t jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+    m_joints[jointIndex].feedforward = m_effort[jointIndex];
+}
+
+template <>
+double trajectoryController<effortHardware>::computeCommand(
+  joint_t& joint, double trajectoryTime, const ros::Duration& period)
+{
+  double correction = joint.scheduleUp.empty()
+    ? joint.pid.computeCommand(joint.error, period)
+    : computeScheduledCommand(joint, period.toSec());
+
+  return correction + joint.feedforward;
+}
+
+template <>
+double trajectoryController<effortHardware>::limitCommand(const joint_t& joint, double command) const
+{
+  return utilities::clamp(command, -joint.maxEffort, joint.maxEffort);
+}
+
+template <>
+void trajectoryController<effortHardware>::holdCommands()
+{
+  // Hold joints against gravity when the model is available
+  if (m_feedforward)
+  {
+    for (size_t jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+      m_ahead[jointIndex] = m_joints[jointIndex].handle.getPosition();
+
+    m_dynamics.gravity(m_ahead, m_effort);
+  }
+
+  for (size_t jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+    m_joints[jointIndex].handle.setCommand(m_feedforward ? m_effort[jointIndex] : 0.0);
+}
+
+/*----------------------------------------------------------*\
+| Instantiations
+\*----------------------------------------------------------*/
+
+template class str1ker::trajectoryController<positionHardware>;
+template class str1ker::trajectoryController<velocityHardware>;
+template class str1ker::trajectoryController<effortHardware>;
+
+// Model predictive controller replaces the velocity command law
+template void str1ker::trajectoryController<velocityHardware>::updateTrajectory(
+  mpcTrajectoryController& law, const ros::Time& time, const ros::Duration& period);
+
+PLUGINLIB_EXPORT_CLASS(str1ker::positionTrajectoryController, controller_interface::ControllerBase);
 PLUGINLIB_EXPORT_CLASS(str1ker::jointTrajectoryController, controller_interface::ControllerBase);
+PLUGINLIB_EXPORT_CLASS(str1ker::effortTrajectoryController, controller_interface::ControllerBase);
@@ -23,12 +23,17 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 #include <actionlib/server/action_server.h>
 #include <actionlib/client/simple_action_client.h>
 #include <control_msgs/FollowJointTrajectoryAction.h>
 #include <control_msgs/JointTrajectoryControllerState.h>
 #include <control_msgs/QueryTrajectoryState.h>
+#include <realtime_tools/realtime_publisher.h>
 
 #include <controller_manager/controller_manager.h>
 #include <controller_interface/controller.h>
@@ -38,13 +43,17 @@
 #include <control_toolbox/pid.h>
 #include <angles/angles.h>
 #include <urdf/model.h>
+#include <str1ker/HardwareStatus.h>
+#include "inverseDynamics.h"
+#include "configSnapshot.h"
 
 /*----------------------------------------------------------*\
 | Definitions
 \*----------------------------------------------------------*/
 
+typedef hardware_interface::PositionJointInterface positionHardware;
 typedef hardware_interface::VelocityJointInterface velocityHardware;
-typedef controller_interface::Controller<velocityHardware> velocityController;
+typedef hardware_interface::EffortJointInterface effortHardware;
 typedef actionlib::ActionServer<control_msgs::FollowJointTrajectoryAction> trajectoryActionServer;
 
 /*----------------------------------------------------------*\
@@ -54,12 +63,13 @@ typedef actionlib::ActionServer<control_msgs::FollowJointTrajectoryAction> traje
 namespace str1ker {
 
 /*----------------------------------------------------------*\
-| jointTrajectoryController class
+| trajectoryController class
 \*----------------------------------------------------------*/
 
-class jointTrajectoryController : public velocityController
+template <class hardwareInterface>
+class trajectoryController : public controller_interface::Controller<hardwareInterface>
 {
-private:
+protected:
   //
   // Types
   //
@@ -77,6 +87,20 @@ private:
     PRISMATIC = 3
   };
 
+  struct gains_t
+  {
+    double position;
+    double p;
+    double i;
+    double d;
+  };
+
+  struct sample_t
+  {
+    double time;
+    double position;
+  };
+
   struct joint_t
   {
     std::string name;
@@ -92,10 +116,17 @@ private:
     double min;
     double max;
     double maxVelocity;
+    double maxEffort;
 
     // Configuration from YAML
     double tolerance;
     double timeout;
+    double timeConstant;
+    double transferTime;
+
+    // Gain schedules sorted by position for each drive direction, empty if not scheduled
+    std::vector<gains_t> scheduleUp;
+    std::vector<gains_t> scheduleDown;
 
     // State
     double goal = {0.0};
@@ -103,15 +134,84 @@ private:
     double vel = {0.0};
     double error = {0.0};
     double command = {0.0};
+    double feedforward = {0.0};
     bool completed = {false};
+
+    // Smith predictor plant model without delay
+    double modelPos = {0.0};
+    double modelVel = {0.0};
+    double predicted = {0.0};
+
+    // Model positions of recent cycles, newest at head
+    std::vector<sample_t> history;
+    int head = {0};
+    int samples = {0};
+
+    // Scheduled gains in effect, gain-weighted error integral, last error and whether it is set
+    gains_t gains = {0.0, 0.0, 0.0, 0.0};
+    double integral = {0.0};
+    double lastError = {0.0};
+    bool hasLastError = {false};
   };
 
-  struct waypoint_t
+public:
+  struct trajectory_t
   {
-    std::vector<double> position;
-    double time;
+    // Shared by callback threads and the update loop, never modified once parsed
+    typedef std::shared_ptr<const trajectory_t> ConstPtr;
+
+    // Waypoints as rows of time followed by joint positions, then velocities and accelerations if planned
+    std::vector<double> points;
+
+    // Values in each row
+    size_t stride = {1};
+
+    // Joints in each row
+    size_t joints = {0};
+
+    // Whether rows carry planned velocities and accelerations
+    bool derivatives = {false};
+
+    // Strike event times from start, in order
+    std::vector<double> strikes;
+
+    // Time the goal was received, correlation ID and action goal if any
+    ros::Time start;
+    uint32_t traceId = {0};
+    trajectoryActionServer::GoalHandle goal;
+
+    size_t size() const { return points.size() / stride; }
+    double time(size_t index) const { return points[index * stride]; }
+    const double* position(size_t index) const { return &points[index * stride + 1]; }
+    const double* velocity(size_t index) const { return &points[index * stride + 1 + joints]; }
+    const double* acceleration(size_t index) const { return &points[index * stride + 1 + joints * 2]; }
+
+    // First waypoint after the given time, upper bound on the time column
+    size_t upperBound(double timeFromStart) const
+    {
+      size_t index = 0;
+      size_t count = size();
+
+      while (count > 0)
+      {
+        size_t step = count / 2;
+
+        if (time(index + step) <= timeFromStart)
+        {
+          index += step + 1;
+          count -= step + 1;
+        }
+        else
+        {
+          count = step;
+        }
+      }
+
+      return index;
+    }
   };
 
+private:
   //
   // Constants
   //
@@ -122,15 +222,25 @@ private:
   const double DEFAULT_P = 10.0;
   const double DEFAULT_I = 1.0;
   const double DEFAULT_D = 1.0;
+  const double DEFAULT_TIME_CONSTANT = 0.05;
+  const double DEFAULT_TRANSFER_TIME = 0.1;
+  const double FEEDFORWARD_STEP = 0.01;
+  const int HISTORY_SIZE = 64;
 
-private:
+protected:
   //
   // Configuration
   //
 
   std::string m_name;
   std::vector<joint_t> m_joints;
+  std::unordered_map<std::string, int> m_jointIndexes;
+  std::string m_strikeJoint;
   bool m_debug = false;
+  bool m_feedforward = false;
+  bool m_delayCompensation = false;
+  double m_delay = 0.0;
+  double m_extraDelay = 0.0;
 
   //
   // Interface
@@ -138,12 +248,14 @@ private:
 
   ros::NodeHandle m_node;
   ros::Subscriber m_goalSub;
-  ros::Publisher m_statePub;
-  ros::Publisher m_feedbackPub;
+  ros::Subscriber m_statusSub;
+  std::shared_ptr<realtime_tools::RealtimePublisher<control_msgs::JointTrajectoryControllerState>> m_pStatePub;
+  std::shared_ptr<realtime_tools::RealtimePublisher<control_msgs::FollowJointTrajectoryFeedback>> m_pFeedbackPub;
   ros::Publisher m_resultPub;
   ros::ServiceServer m_stateService;
   std::shared_ptr<trajectoryActionServer> m_pGoalServer;
-  velocityHardware* m_hardware;
+  hardwareInterface* m_hardware;
+  hardware_interface::JointHandle m_strike;
 
   //
   // State
@@ -151,17 +263,37 @@ private:
 
   trajectoryState m_state;
   trajectoryActionServer::GoalHandle m_goal;
-  std::vector<waypoint_t> m_trajectory;
+  typename trajectory_t::ConstPtr m_trajectory;
+  typename trajectory_t::ConstPtr m_received;
+  size_t m_nextStrike = 0;
+  std::vector<double> m_position;
+  std::vector<double> m_ahead;
+  std::vector<double> m_ahead2;
+  std::vector<double> m_referenceVel;
+  std::vector<double> m_referenceAccel;
+  std::vector<double> m_effort;
+  inverseDynamics m_dynamics;
   uint32_t m_seq;
+  uint32_t m_traceId = 0;
   ros::Time m_startTime;
   ros::Time m_lastTime;
+  std::atomic<double> m_transportDelay{ 0.0 };
+
+  //
+  // Goal handoff, parsed by callback threads and started by the update loop
+  //
+
+  std::mutex m_parseLock;
+  typename trajectory_t::ConstPtr m_latest;
+  configSnapshot<typename trajectory_t::ConstPtr> m_pending;
+  std::atomic<bool> m_cancel{ false };
 
 public:
   //
   // Initialization
   //
 
-  bool init(velocityHardware* hw, ros::NodeHandle& managerNode, ros::NodeHandle& node);
+  bool init(hardwareInterface* hw, ros::NodeHandle& managerNode, ros::NodeHandle& node);
 
   //
   // Lifecycle
@@ -171,6 +303,9 @@ public:
   void stopping(const ros::Time&);
   void update(const ros::Time& time, const ros::Duration& period);
 
+  // Run the update with the command law bound at compile time, derived controllers pass themselves
+  template <class commandLaw> void updateTrajectory(commandLaw& law, const ros::Time& time, const ros::Duration& period);
+
   //
   // ROS and MoveIt Interface
   //
@@ -180,16 +315,116 @@ public:
   void trajectoryActionCallback(trajectoryActionServer::GoalHandle goal);
   void trajectoryCancelCallback(trajectoryActionServer::GoalHandle goal);
   bool trajectoryQueryCallback(control_msgs::QueryTrajectoryState::Request& req, control_msgs::QueryTrajectoryState::Response& res);
+  void hardwareStatusCallback(const HardwareStatus::ConstPtr& msg);
 
   //
   // Trajectory management
   //
   
-  void parseTrajectory(const trajectory_msgs::JointTrajectory& trajectory);
-  void beginTrajectory(const ros::Time& time, const std::vector<waypoint_t>& waypoints);
-  void runTrajectory(const ros::Time& time, const ros::Duration& period);
-  const waypoint_t* sampleTrajectory(double timeFromStart, std::vector<double>& position);
+  int32_t parseTrajectory(
+    const trajectory_msgs::JointTrajectory& trajectory,
+    const ros::Time& time,
+    trajectoryActionServer::GoalHandle goal = trajectoryActionServer::GoalHandle());
+  void beginTrajectory(typename trajectory_t::ConstPtr& trajectory);
+  template <class commandLaw> void runTrajectory(commandLaw& law, const ros::Time& time, const ros::Duration& period);
+  int sampleTrajectory(double timeFromStart, std::vector<double>& position) const;
+  static int sampleTrajectory(const trajectory_t& trajectory, double timeFromStart, std::vector<double>& position);
+  static bool sampleDerivatives(
+    const trajectory_t& trajectory,
+    double timeFromStart,
+    std::vector<double>& velocity,
+    std::vector<double>& acceleration);
   void endTrajectory();
+  void fireStrikes(double trajectoryTime, const ros::Duration& period);
+
+  //
+  // Command law, specialized for each hardware interface and hidden by derived controllers
+  //
+
+  bool initCommands(const urdf::Model& model);
+  void prepareCommands(double trajectoryTime);
+  double computeCommand(joint_t& joint, double trajectoryTime, const ros::Duration& period);
+  double limitCommand(const joint_t& joint, double command) const;
+  void holdCommands();
+  void sampleReference(double trajectoryTime);
+
+  //
+  // Gain scheduling
+  //
+
+  bool loadSchedule(ros::NodeHandle& node, joint_t& joint);
+  static gains_t interpolateGains(const std::vector<gains_t>& schedule, double position);
+  double computeScheduledCommand(joint_t& joint, double period);
+
+  //
+  // Delay compensation
+  //
+
+  void resetPrediction(joint_t& joint, double time);
+  double predictPosition(joint_t& joint, double time, double period);
+  double getDelay() const;
+
+  //
+  // State
+  //
+
+  inline bool isExecuting() const
+  {
+    return m_state == trajectoryState::EXECUTING;
+  }
+
+  inline size_t getJointCount() const
+  {
+    return m_joints.size();
+  }
+
+  inline const std::string& getJointName(size_t jointIndex) const
+  {
+    return m_joints[jointIndex].name;
+  }
 };
 
+/*----------------------------------------------------------*\
+| Command law specializations
+\*----------------------------------------------------------*/
+
+// Position interface passes interpolated setpoints through
+template <> bool trajectoryController<positionHardware>::initCommands(const urdf::Model& model);
+template <> void trajectoryController<positionHardware>::prepareCommands(double trajectoryTime);
+template <> double trajectoryController<positionHardware>::computeCommand(
+  joint_t& joint, double trajectoryTime, const ros::Duration& period);
+template <> double trajectoryController<positionHardware>::limitCommand(
+  const joint_t& joint, double command) const;
+template <> void trajectoryController<positionHardware>::holdCommands();
+
+// Velocity interface closes PID around position with velocity feedforward
+template <> bool trajectoryController<velocityHardware>::initCommands(const urdf::Model& model);
+template <> void trajectoryController<velocityHardware>::prepareCommands(double trajectoryTime);
+template <> double trajectoryController<velocityHardware>::computeCommand(
+  joint_t& joint, double trajectoryTime, const ros::Duration& period);
+template <> double trajectoryController<velocityHardware>::limitCommand(
+  const joint_t& joint, double command) const;
+template <> void trajectoryController<velocityHardware>::holdCommands();
+
+// Effort interface closes PID around position with inverse dynamics feedforward
+template <> bool trajectoryController<effortHardware>::initCommands(const urdf::Model& model);
+template <> void trajectoryController<effortHardware>::prepareCommands(double trajectoryTime);
+template <> double trajectoryController<effortHardware>::computeCommand(
+  joint_t& joint, double trajectoryTime, const ros::Duration& period);
+template <> double trajectoryController<effortHardware>::limitCommand(
+  const joint_t& joint, double command) const;
+template <> void trajectoryController<effortHardware>::holdCommands();
+
+/*----------------------------------------------------------*\
+| Instantiations
+\*----------------------------------------------------------*/
+
+extern template class trajectoryController<positionHardware>;
+extern template class trajectoryController<velocityHardware>;
+extern template class trajectoryController<effortHardware>;
+
+typedef trajectoryController<positionHardware> positionTrajectoryController;
+typedef trajectoryController<velocityHardware> jointTrajectoryController;
+typedef trajectoryController<effortHardware> effortTrajectoryController;
+
 } // namespace str1ker
@@ -0,0 +1,89 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ messagePool.h
+
+ Reusable messages for zero-copy publishing
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <stddef.h>
+#include <boost/shared_ptr.hpp>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| messagePool class
+\*----------------------------------------------------------*/
+
+//
+// Fixed set of messages published by shared pointer. Subscribers in
+// the same process receive the pointer instead of a serialized copy,
+// so a message can only be reused once no subscriber holds it. Taking
+// a free message never allocates and keeps vector capacity from its
+// last use; a copy is allocated only if every message is still held.
+// Single publishing thread.
+//
+
+template<class M, size_t SIZE = 4> class messagePool
+{
+private:
+  // Messages, each either free or held by subscriber queues
+  boost::shared_ptr<M> m_messages[SIZE];
+
+  // Next message to try
+  size_t m_next;
+
+public:
+  messagePool()
+    : m_next(0)
+  {
+  }
+
+public:
+  // Fill pool with copies of a prototype, call before publishing
+  void init(const M& prototype)
+  {
+    for (size_t index = 0; index < SIZE; index++)
+      m_messages[index].reset(new M(prototype));
+  }
+
+  // Take a message no subscriber holds, contents are from its last use
+  boost::shared_ptr<M> acquire()
+  {
+    for (size_t attempt = 0; attempt < SIZE; attempt++)
+    {
+      boost::shared_ptr<M>& message = m_messages[m_next];
+      m_next = (m_next + 1) % SIZE;
+
+      if (message.unique()) return message;
+    }
+
+    // Subscribers are slow, replace the oldest message
+    boost::shared_ptr<M>& message = m_messages[m_next];
+    m_next = (m_next + 1) % SIZE;
+    message.reset(new M(*message));
+
+    return message;
+  }
+};
+
+} // namespace str1ker
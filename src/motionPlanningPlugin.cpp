@@ -262,17 +262,40 @@ vector<RobotStatePtr> PluginContext::interpolateQuintic(
         {
             const string& jointName = constraints[jointIndex].joint_name;
             double jointState = 0.0;
+            double jointVelocity = 0.0;
+            double jointAcceleration = 0.0;
 
             for (size_t coeffIndex = 0;
                 coeffIndex < QUINTIC_COEFFICIENTS;
                 coeffIndex++)
             {
-                jointState
-                    += stepPowers[coeffIndex]
-                    * coefficients[jointIndex].all[coeffIndex];
+                double coefficient = coefficients[jointIndex].all[coeffIndex];
+
+                jointState += stepPowers[coeffIndex] * coefficient;
+
+                // Differentiate the polynomial analytically
+                if (coeffIndex >= 1)
+                {
+                    jointVelocity
+                        += coeffIndex
+                        * stepPowers[coeffIndex - 1]
+                        * coefficient;
+                }
+
+                if (coeffIndex >= 2)
+                {
+                    jointAcceleration
+                        += coeffIndex * (coeffIndex - 1)
+                        * stepPowers[coeffIndex - 2]
+                        * coefficient;
+                }
             }
 
+            // Spline is parameterized by step, convert derivatives to time
             pState->setJointPositions(jointName, &jointState);
+            pState->setVariableVelocity(jointName, jointVelocity / STEP_DURATION);
+            pState->setVariableAcceleration(
+                jointName, jointAcceleration / (STEP_DURATION * STEP_DURATION));
         }
 
         trajectory[step] = pState;
@@ -288,11 +311,24 @@ vector<RobotStatePtr> PluginContext::interpolateLinear(
     int steps)
 {
     vector<RobotStatePtr> trajectory(steps);
+    double duration = steps * STEP_DURATION;
 
     for (size_t step = 0; step < steps; step++)
     {
         RobotStatePtr pState(new RobotState(pStartState->getRobotModel()));
         pStartState->interpolate(*pEndState, double(step) / double(steps), *pState);
+
+        // Constant velocity between start and goal
+        for (const moveit_msgs::JointConstraint& constraint: constraints)
+        {
+            const string& jointName = constraint.joint_name;
+            double distance = *pEndState->getJointPositions(jointName)
+                - *pStartState->getJointPositions(jointName);
+
+            pState->setVariableVelocity(jointName, distance / duration);
+            pState->setVariableAcceleration(jointName, 0.0);
+        }
+
         trajectory[step] = pState;
     }
 
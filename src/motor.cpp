@@ -19,10 +19,15 @@
 | Includes
 \*----------------------------------------------------------*/
 
+#include <algorithm>
+#include <cmath>
 #include <ros/ros.h>
 #include "robot.h"
 #include "motor.h"
 #include "controllerFactory.h"
+#include "controllerUtilities.h"
+#include "trace.h"
+#include "recorder.h"
 
 /*----------------------------------------------------------*\
 | Namespace
@@ -82,27 +87,154 @@ bool motor::configure()
 {
   controller::configure();
 
-  if (!ros::param::get(getChildPath("topic"), m_topic))
+  if (!getSetting("topic", m_topic))
     ROS_WARN("%s did not specify output topic, using %s", getPath().c_str(), m_topic.c_str());
 
-  if (!ros::param::get(getChildPath("lpwm"), m_lpwm))
+  if (!getSetting("lpwm", m_lpwm))
     ROS_WARN("%s did not specify lpwm channel, using %d", getPath().c_str(), m_lpwm);
 
-  if (!ros::param::get(getChildPath("rpwm"), m_rpwm))
+  if (!getSetting("rpwm", m_rpwm))
     ROS_WARN("%s did not specify rpwm channel, using %d", getPath().c_str(), m_rpwm);
 
-  if (!ros::param::get(getChildPath("minPwm"), m_minPwm))
+  if (!getSetting("minPwm", m_minPwm))
     ROS_WARN("%s did not specify minPwm value, using %d", getPath().c_str(), m_minPwm);
 
-  if (!ros::param::get(getChildPath("maxPwm"), m_maxPwm))
+  if (!getSetting("maxPwm", m_maxPwm))
     ROS_WARN("%s did not specify maxPwm value, using %d", getPath().c_str(), m_maxPwm);
 
-  if (!ros::param::get(getChildPath("minVelocity"), m_minVelocity))
+  if (!getSetting("minVelocity", m_minVelocity))
     ROS_WARN("%s did not specify minVelocity, using %g", getPath().c_str(), m_minVelocity);
 
-  if (!ros::param::get(getChildPath("maxVelocity"), m_maxVelocity))
+  if (!getSetting("maxVelocity", m_maxVelocity))
     ROS_WARN("%s did not specify maxVelocity, using %g", getPath().c_str(), m_maxVelocity);
 
+  if (!getSetting("deceleration", m_deceleration))
+    ROS_WARN("%s did not specify deceleration, position limits not enforced", getPath().c_str());
+
+  if (!getSetting("dutyPerEffort", m_dutyPerEffort))
+    ROS_WARN("%s did not specify dutyPerEffort, effort feedforward disabled", getPath().c_str());
+
+  if (!getSetting("viscousPwm", m_viscousPwm))
+    ROS_WARN("%s did not specify viscousPwm, friction compensation disabled", getPath().c_str());
+
+  getSetting("breakawayPwm", m_breakawayPwm);
+  getSetting("coulombPwm", m_coulombPwm);
+  getSetting("stribeckVelocity", m_stribeckVelocity);
+  getSetting("backlash", m_backlash);
+  getSetting("backlashVelocity", m_backlashVelocity);
+  getSetting("calibrate", m_calibrate);
+
+  m_staged.minPwm = m_minPwm;
+  m_staged.maxPwm = m_maxPwm;
+  m_staged.minVelocity = m_minVelocity;
+  m_staged.maxVelocity = m_maxVelocity;
+  m_staged.deceleration = m_deceleration;
+  m_staged.dutyPerEffort = m_dutyPerEffort;
+  m_staged.breakawayPwm = m_breakawayPwm;
+  m_staged.coulombPwm = m_coulombPwm;
+  m_staged.viscousPwm = m_viscousPwm;
+  m_staged.stribeckVelocity = m_stribeckVelocity;
+  m_staged.backlash = m_backlash;
+  m_staged.backlashVelocity = m_backlashVelocity;
+
+  return true;
+}
+
+//
+// Reload
+//
+
+bool motor::stage(XmlRpc::XmlRpcValue& settings)
+{
+  // Topic and channels require a restart
+  reloadable_t staged = m_staged;
+
+  controllerUtilities::getSetting(settings, "minPwm", staged.minPwm);
+  controllerUtilities::getSetting(settings, "maxPwm", staged.maxPwm);
+  controllerUtilities::getSetting(settings, "minVelocity", staged.minVelocity);
+  controllerUtilities::getSetting(settings, "maxVelocity", staged.maxVelocity);
+  controllerUtilities::getSetting(settings, "deceleration", staged.deceleration);
+  controllerUtilities::getSetting(settings, "dutyPerEffort", staged.dutyPerEffort);
+  controllerUtilities::getSetting(settings, "breakawayPwm", staged.breakawayPwm);
+  controllerUtilities::getSetting(settings, "coulombPwm", staged.coulombPwm);
+  controllerUtilities::getSetting(settings, "viscousPwm", staged.viscousPwm);
+  controllerUtilities::getSetting(settings, "stribeckVelocity", staged.stribeckVelocity);
+  controllerUtilities::getSetting(settings, "backlash", staged.backlash);
+  controllerUtilities::getSetting(settings, "backlashVelocity", staged.backlashVelocity);
+
+  if (staged.minPwm < 0 || staged.maxPwm < staged.minPwm || staged.maxPwm > UINT16_MAX)
+  {
+    ROS_ERROR("%s PWM range [%d, %d] is invalid", getPath().c_str(), staged.minPwm, staged.maxPwm);
+    return false;
+  }
+
+  if (staged.minVelocity < 0.0 || staged.maxVelocity <= staged.minVelocity)
+  {
+    ROS_ERROR("%s velocity range [%g, %g] is invalid", getPath().c_str(), staged.minVelocity, staged.maxVelocity);
+    return false;
+  }
+
+  if (staged.deceleration < 0.0)
+  {
+    ROS_ERROR("%s deceleration must not be negative", getPath().c_str());
+    return false;
+  }
+
+  if (staged.dutyPerEffort < 0.0)
+  {
+    ROS_ERROR("%s dutyPerEffort must not be negative", getPath().c_str());
+    return false;
+  }
+
+  if (staged.breakawayPwm < 0.0 || staged.coulombPwm < 0.0 || staged.viscousPwm < 0.0 ||
+      staged.stribeckVelocity < 0.0)
+  {
+    ROS_ERROR("%s friction model must not be negative", getPath().c_str());
+    return false;
+  }
+
+  if (staged.backlash < 0.0 || staged.backlashVelocity < 0.0)
+  {
+    ROS_ERROR("%s backlash must not be negative", getPath().c_str());
+    return false;
+  }
+
+  m_staged = staged;
+
+  return true;
+}
+
+void motor::release()
+{
+  m_reload.publish(m_staged);
+}
+
+bool motor::commit()
+{
+  reloadable_t reloaded;
+
+  if (!m_reload.consume(reloaded)) return false;
+
+  m_minPwm = reloaded.minPwm;
+  m_maxPwm = reloaded.maxPwm;
+  m_minVelocity = reloaded.minVelocity;
+  m_maxVelocity = reloaded.maxVelocity;
+  m_deceleration = reloaded.deceleration;
+  m_dutyPerEffort = reloaded.dutyPerEffort;
+  m_breakawayPwm = reloaded.breakawayPwm;
+  m_coulombPwm = reloaded.coulombPwm;
+  m_viscousPwm = reloaded.viscousPwm;
+  m_stribeckVelocity = reloaded.stribeckVelocity;
+  m_backlash = reloaded.backlash;
+  m_backlashVelocity = reloaded.backlashVelocity;
+
+  // Side of the backlash gap is unknown after changing it
+  m_direction = 0.0;
+  m_slack = 0.0;
+
+  // Re-send current command with the new mapping
+  reset();
+
   return true;
 }
 
@@ -118,6 +250,20 @@ bool motor::init()
     QUEUE_SIZE
   );
 
+  // Channels require a restart, only values change per command
+  Pwm prototype;
+  prototype.channels.resize(2);
+
+  // LPWM
+  prototype.channels[0].channel = m_lpwm;
+  prototype.channels[0].mode = PwmChannel::MODE_ANALOG;
+
+  // RPWM
+  prototype.channels[1].channel = m_rpwm;
+  prototype.channels[1].mode = PwmChannel::MODE_ANALOG;
+
+  m_pwm.init(prototype);
+
   ROS_INFO("  initialized %s %s on %s: (LPWM %d RPWM %d) [%d, %d] -> [%g, %g]",
     getPath().c_str(),
     getType().c_str(),
@@ -136,37 +282,143 @@ bool motor::init()
 // Velocity command
 //
 
-void motor::command(double velocity)
+void motor::feedback(double velocity, double period)
+{
+  m_measuredVelocity = velocity;
+  m_period = period;
+}
+
+void motor::command(double velocity, double effort)
 {
-  if (!m_enable || abs(m_velocity - velocity) <= std::numeric_limits<double>().epsilon())
+  // Changing effort only matters if it changes the pulse width
+  if (m_dutyPerEffort <= 0.0) effort = 0.0;
+
+  // Compensation changes pulse width with measured motion, compare pulse widths instead
+  bool compensated = isCompensated();
+  bool resend = isinf(m_velocity);
+
+  if (!m_enable ||
+    (!compensated &&
+    abs(m_velocity - velocity) <= std::numeric_limits<double>().epsilon() &&
+    abs(m_effort - effort) <= std::numeric_limits<double>().epsilon()))
   {
     return;
   }
 
   m_velocity = utilities::clampZero(abs(velocity), m_minVelocity, m_maxVelocity);
+  m_effort = effort;
 
-  uint16_t dutyCycle = (uint16_t)utilities::mapZero(
-    m_velocity, m_minVelocity, m_maxVelocity, (double)m_minPwm, (double)m_maxPwm);
+  double direction = velocity >= 0 ? 1.0 : -1.0;
 
-  m_lpwmCommand = (velocity >= 0 ? 0 : dutyCycle);
-  m_rpwmCommand = (velocity >= 0 ? dutyCycle : 0);
+  uint16_t dutyCycle = compensated
+    ? (uint16_t)compensate(m_velocity, direction)
+    : (uint16_t)utilities::mapZero(
+      m_velocity, m_minVelocity, m_maxVelocity, (double)m_minPwm, (double)m_maxPwm);
 
-  Pwm msg;
-  msg.channels.resize(2);
+  if (dutyCycle && !utilities::isZero(effort))
+  {
+    // Offset toward the load, never reversing or stopping the commanded direction
+    double offset = direction * effort * m_dutyPerEffort;
 
-  // LPWM
-  msg.channels[0].channel = m_lpwm;
-  msg.channels[0].mode = PwmChannel::MODE_ANALOG;
-  msg.channels[0].value = m_lpwmCommand;
+    dutyCycle = (uint16_t)utilities::clamp(
+      double(dutyCycle) + offset, double(m_minPwm), double(m_maxPwm));
+  }
 
-  // RPWM
-  msg.channels[1].channel = m_rpwm;
-  msg.channels[1].mode = PwmChannel::MODE_ANALOG;
-  msg.channels[1].value = m_rpwmCommand;
+  publish(
+    velocity >= 0 ? 0 : dutyCycle,
+    velocity >= 0 ? dutyCycle : 0,
+    !compensated || resend);
+}
+
+void motor::drive(double dutyCycle)
+{
+  if (!m_enable) return;
+
+  uint16_t pulseWidth = (uint16_t)utilities::clamp(abs(dutyCycle), 0.0, (double)m_maxPwm);
+
+  // Next velocity command is sent even if unchanged
+  reset();
+
+  publish(
+    dutyCycle >= 0 ? 0 : pulseWidth,
+    dutyCycle >= 0 ? pulseWidth : 0,
+    false);
+}
+
+double motor::compensate(double velocity, double direction)
+{
+  // Stopping leaves the gap where it was
+  if (utilities::isZero(velocity)) return 0.0;
+
+  if (m_backlash > 0.0)
+  {
+    // Reversing opens the whole gap, the side is unknown before the first move
+    if (direction != m_direction)
+    {
+      m_slack = m_direction != 0.0 ? m_backlash : 0.0;
+      m_direction = direction;
+    }
+
+    // Output following the command means the gap already closed
+    if (direction * m_measuredVelocity >= velocity / 2.0) m_slack = 0.0;
+
+    if (m_slack > 0.0)
+    {
+      // Cross the gap fast so the output doesn't wait on a slow command
+      double crossing = min(
+        max(velocity, m_backlashVelocity > 0.0 ? m_backlashVelocity : m_maxVelocity),
+        m_maxVelocity);
+
+      m_slack -= crossing * m_period;
+      velocity = crossing;
+    }
+  }
+
+  if (m_viscousPwm <= 0.0)
+  {
+    return utilities::mapZero(
+      velocity, m_minVelocity, m_maxVelocity, (double)m_minPwm, (double)m_maxPwm);
+  }
+
+  // Breakaway friction holds until the output moves the commanded way, then fades to Coulomb
+  double moving = max(direction * m_measuredVelocity, 0.0);
+  double stiction = m_stribeckVelocity > 0.0
+    ? exp(-(moving / m_stribeckVelocity) * (moving / m_stribeckVelocity))
+    : 0.0;
+
+  double dutyCycle =
+    m_coulombPwm +
+    max(m_breakawayPwm - m_coulombPwm, 0.0) * stiction +
+    m_viscousPwm * velocity;
+
+  return utilities::clamp(dutyCycle, 0.0, (double)m_maxPwm);
+}
+
+void motor::publish(uint16_t lpwm, uint16_t rpwm, bool force)
+{
+  if (!force && lpwm == m_lpwmCommand && rpwm == m_rpwmCommand) return;
+
+  m_lpwmCommand = lpwm;
+  m_rpwmCommand = rpwm;
+
+  // Published by pointer so nodelets in this process share it
+  Pwm::Ptr msg = m_pwm.acquire();
+
+  msg->channels[0].value = m_lpwmCommand;
+  msg->channels[1].value = m_rpwmCommand;
+
+  msg->trace = trace::getContext();
+  trace::instant("pwm", msg->trace);
+  recorder::write(recorder::PWM, *msg);
 
   m_pwmPub.publish(msg);
 }
 
+void motor::reset()
+{
+  m_velocity = INFINITY;
+}
+
 //
 // Dynamic creation
 //
@@ -24,6 +24,8 @@
 #include <ros/ros.h>
 #include <str1ker/Pwm.h>
 #include "controller.h"
+#include "configSnapshot.h"
+#include "messagePool.h"
 #include "hardwareUtilities.h"
 
 /*----------------------------------------------------------*\
@@ -55,9 +57,29 @@ private:
   // Default max velocity
   const double VELOCITY_MAX = 1.0;
 
+  // Default deceleration (0 disables braking before position limits)
+  const double DECELERATION = 0.0;
+
   // Publish queue size
   const int QUEUE_SIZE = 8;
 
+  // Settings that can be reloaded while running
+  struct reloadable_t
+  {
+    int minPwm;
+    int maxPwm;
+    double minVelocity;
+    double maxVelocity;
+    double deceleration;
+    double dutyPerEffort;
+    double breakawayPwm;
+    double coulombPwm;
+    double viscousPwm;
+    double stribeckVelocity;
+    double backlash;
+    double backlashVelocity;
+  };
+
 private:
   //
   // Configuration
@@ -84,6 +106,42 @@ private:
   // Max velocity in physical units
   double m_maxVelocity = VELOCITY_MAX;
 
+  // Deceleration the actuator can sustain in physical units per second squared
+  double m_deceleration = DECELERATION;
+
+  // PWM pulse width added per unit of effort feedforward (0 disables)
+  double m_dutyPerEffort = 0.0;
+
+  // PWM pulse width that starts motion from rest
+  double m_breakawayPwm = 0.0;
+
+  // PWM pulse width that keeps the actuator moving at vanishing velocity
+  double m_coulombPwm = 0.0;
+
+  // PWM pulse width per unit of velocity (0 disables friction model)
+  double m_viscousPwm = 0.0;
+
+  // Velocity over which breakaway friction decays to Coulomb friction
+  double m_stribeckVelocity = 0.0;
+
+  // Travel lost to gear backlash on direction reversal (0 disables)
+  double m_backlash = 0.0;
+
+  // Velocity to cross the backlash gap at (0 uses max velocity)
+  double m_backlashVelocity = 0.0;
+
+  // Whether friction calibration drives this actuator
+  bool m_calibrate = false;
+
+  // Whether velocity feedback is measured rather than echoed from commands
+  bool m_velocityMeasured = false;
+
+  // Settings staged by reload, owned by reload thread
+  reloadable_t m_staged;
+
+  // Settings handed from reload thread to update loop
+  configSnapshot<reloadable_t> m_reload;
+
   //
   // Interface
   //
@@ -91,6 +149,9 @@ private:
   // PWM publisher to motor driver
   ros::Publisher m_pwmPub;
 
+  // PWM messages sized once in init and reused for each command
+  messagePool<Pwm> m_pwm;
+
   //
   // State
   //
@@ -104,6 +165,17 @@ private:
   // Last velocity command
   double m_velocity = INFINITY;
 
+  // Last effort feedforward
+  double m_effort = 0.0;
+
+  // Measured velocity and update period for friction and backlash compensation
+  double m_measuredVelocity = 0.0;
+  double m_period = 0.0;
+
+  // Direction of the last move and backlash left to cross
+  double m_direction = 0.0;
+  double m_slack = 0.0;
+
 public:
   //
   // Constructors
@@ -130,6 +202,12 @@ public:
     return m_velocity;
   }
 
+  // Get deceleration the actuator can sustain
+  inline double getDeceleration()
+  {
+    return m_deceleration;
+  }
+
   // Get current LPWM pulse width
   inline int getLPWM()
   {
@@ -142,18 +220,89 @@ public:
     return m_rpwmCommand;
   }
 
+  // Get PWM pulse width range
+  inline int getMinPwm() const
+  {
+    return m_minPwm;
+  }
+
+  inline int getMaxPwm() const
+  {
+    return m_maxPwm;
+  }
+
+  // Get velocity range mapped to PWM range
+  inline double getMinVelocity() const
+  {
+    return m_minVelocity;
+  }
+
+  inline double getMaxVelocity() const
+  {
+    return m_maxVelocity;
+  }
+
+  // Whether friction calibration drives this actuator
+  inline bool shouldCalibrate() const
+  {
+    return m_calibrate && m_velocityMeasured;
+  }
+
+  // Whether friction or backlash compensation is enabled
+  inline bool isCompensated() const
+  {
+    return m_velocityMeasured && (m_viscousPwm > 0.0 || m_backlash > 0.0);
+  }
+
+  // Whether compensation settings are given, enabled only with measured velocity
+  inline bool wantsCompensation() const
+  {
+    return m_calibrate || m_viscousPwm > 0.0 || m_backlash > 0.0;
+  }
+
+  // Compensation and calibration need velocity measured by quadrature or an observer
+  inline void setVelocityMeasured(bool measured)
+  {
+    m_velocityMeasured = measured;
+  }
+
   // Load settings
   virtual bool configure();
 
   // Initialize
   virtual bool init();
-  
-  // Command velocity
-  void command(double velocity);
+
+  // Validate reloaded settings
+  virtual bool stage(XmlRpc::XmlRpcValue& settings);
+
+  // Hand staged settings to update loop
+  virtual void release();
+
+  // Apply reloaded settings
+  virtual bool commit();
+
+  // Update measured velocity for friction and backlash compensation
+  void feedback(double velocity, double period);
+
+  // Command velocity, effort feedforward is added while moving
+  void command(double velocity, double effort = 0.0);
+
+  // Command signed PWM pulse width directly, bypassing velocity mapping and compensation
+  void drive(double dutyCycle);
+
+  // Forget last command so the next one is sent even if unchanged
+  void reset();
 
 public:
   // Create instance
   static controller* create(ros::NodeHandle node, std::string path);
+
+private:
+  // Compute PWM pulse width for velocity from friction model
+  double compensate(double velocity, double direction);
+
+  // Publish PWM pulse widths unless unchanged
+  void publish(uint16_t lpwm, uint16_t rpwm, bool force);
 };
 
 } // namespace str1ker
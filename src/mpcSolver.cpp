@@ -0,0 +1,187 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ mpcSolver.cpp
+
+ Model Predictive Control Solver
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <algorithm>
+#include <cmath>
+#include "mpcSolver.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace std;
+using namespace Eigen;
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+const int mpcSolver::HORIZON;
+const int mpcSolver::CONSTRAINTS;
+
+/*----------------------------------------------------------*\
+| mpcSolver implementation
+\*----------------------------------------------------------*/
+
+//
+// Initialization
+//
+
+bool mpcSolver::init(
+  double timeConstant,
+  double step,
+  double maxVelocity,
+  double maxAcceleration,
+  double positionWeight,
+  double commandWeight,
+  double rateWeight,
+  int iterations)
+{
+  if (timeConstant <= 0.0 || step <= 0.0 || maxVelocity <= 0.0 ||
+      maxAcceleration <= 0.0 || positionWeight <= 0.0 || iterations <= 0)
+    return false;
+
+  m_step = step;
+  m_maxVelocity = maxVelocity;
+  m_maxChange = maxAcceleration * step;
+  m_positionWeight = positionWeight;
+  m_rateWeight = max(rateWeight, 0.0);
+  m_iterations = iterations;
+
+  // Exact discretization of velocity lagging the command with a time constant
+  double a = exp(-step / timeConstant);
+  double b = timeConstant * (1.0 - a);
+
+  // Free response: position after each step due to initial position and velocity
+  double travel = 0.0;
+
+  for (int row = 0; row < HORIZON; row++)
+  {
+    travel += b * pow(a, row);
+    m_free(row, 0) = 1.0;
+    m_free(row, 1) = travel;
+  }
+
+  // Forced response: position after each step due to a unit command at step col
+  m_forced.setZero();
+
+  for (int col = 0; col < HORIZON; col++)
+  {
+    double pos = 0.0, vel = 0.0, command = 1.0;
+
+    for (int row = col; row < HORIZON; row++)
+    {
+      pos += b * vel + (step - b) * command;
+      vel = a * vel + (1.0 - a) * command;
+      command = 0.0;
+
+      m_forced(row, col) = pos;
+    }
+  }
+
+  // Constraints: command bounds, then command change bounds
+  matrix_t difference = matrix_t::Identity();
+  difference.diagonal(-1).setConstant(-1.0);
+
+  m_constraints.topRows<HORIZON>() = matrix_t::Identity();
+  m_constraints.bottomRows<HORIZON>() = difference;
+
+  // Cost Hessian: tracking error, command effort and command smoothness
+  matrix_t hessian =
+    2.0 * positionWeight * m_forced.transpose() * m_forced +
+    2.0 * max(commandWeight, 0.0) * matrix_t::Identity() +
+    2.0 * m_rateWeight * difference.transpose() * difference;
+
+  // Scale the penalty to the cost so convergence doesn't depend on units
+  m_rho = RHO * hessian.trace() / HORIZON;
+
+  // Factorize once, every iteration is then a matrix-vector product
+  m_inverse = (
+    hessian +
+    SIGMA * matrix_t::Identity() +
+    m_rho * m_constraints.transpose() * m_constraints
+  ).inverse();
+
+  reset(0.0);
+
+  return true;
+}
+
+void mpcSolver::reset(double command)
+{
+  m_commands.setConstant(command);
+  m_z = m_constraints * m_commands;
+  m_y.setZero();
+}
+
+//
+// Solving
+//
+
+double mpcSolver::solve(double position, double velocity, double lastCommand, const double* reference)
+{
+  // Tracking error with zero command over the horizon
+  vector_t error = m_free * Vector2d(position, velocity) - Map<const vector_t>(reference);
+
+  // Linear cost
+  vector_t gradient = 2.0 * m_positionWeight * m_forced.transpose() * error;
+  gradient(0) -= 2.0 * m_rateWeight * lastCommand;
+
+  // Bounds
+  constraintVector_t lower, upper;
+  lower.head<HORIZON>().setConstant(-m_maxVelocity);
+  upper.head<HORIZON>().setConstant(m_maxVelocity);
+  lower.tail<HORIZON>().setConstant(-m_maxChange);
+  upper.tail<HORIZON>().setConstant(m_maxChange);
+  lower(HORIZON) += lastCommand;
+  upper(HORIZON) += lastCommand;
+
+  // Warm start from the previous solution shifted by one step
+  vector_t commands;
+  commands.head<HORIZON - 1>() = m_commands.tail<HORIZON - 1>();
+  commands(HORIZON - 1) = m_commands(HORIZON - 1);
+
+  // Alternating direction method of multipliers with a fixed iteration budget
+  for (int iteration = 0; iteration < m_iterations; iteration++)
+  {
+    commands = m_inverse * (
+      SIGMA * commands - gradient +
+      m_constraints.transpose() * (m_rho * m_z - m_y));
+
+    constraintVector_t projected = m_constraints * commands;
+
+    m_z = (projected + m_y / m_rho).cwiseMax(lower).cwiseMin(upper);
+    m_y += m_rho * (projected - m_z);
+  }
+
+  m_commands = commands;
+
+  // Iterations may stop short of feasibility, the applied command never does
+  double change = max(-m_maxChange, min(commands(0) - lastCommand, m_maxChange));
+  return max(-m_maxVelocity, min(lastCommand + change, m_maxVelocity));
+}
+
+void mpcSolver::predict(double position, double velocity, double* positions) const
+{
+  Map<vector_t> predicted(positions);
+  predicted = m_free * Vector2d(position, velocity) + m_forced * m_commands;
+}
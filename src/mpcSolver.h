@@ -0,0 +1,143 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ mpcSolver.h
+
+ Model Predictive Control Solver
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <Eigen/Dense>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| mpcSolver class
+\*----------------------------------------------------------*/
+
+class mpcSolver
+{
+public:
+  // Prediction steps
+  static const int HORIZON = 10;
+
+  // Constraint rows: velocity bounds followed by acceleration bounds
+  static const int CONSTRAINTS = HORIZON * 2;
+
+  // Fixed size types so solving never allocates
+  typedef Eigen::Matrix<double, HORIZON, 1> vector_t;
+  typedef Eigen::Matrix<double, CONSTRAINTS, 1> constraintVector_t;
+  typedef Eigen::Matrix<double, HORIZON, HORIZON> matrix_t;
+  typedef Eigen::Matrix<double, HORIZON, 2> stateMatrix_t;
+  typedef Eigen::Matrix<double, CONSTRAINTS, HORIZON> constraintMatrix_t;
+
+private:
+  // Default solver iterations per control cycle
+  const int DEFAULT_ITERATIONS = 40;
+
+  // ADMM penalty relative to mean cost curvature
+  const double RHO = 1.0;
+
+  // ADMM proximal term for a strictly convex step
+  const double SIGMA = 1e-6;
+
+private:
+  //
+  // Configuration
+  //
+
+  // Time between prediction steps in seconds
+  double m_step = 0.0;
+
+  // Velocity command bound
+  double m_maxVelocity = 0.0;
+
+  // Velocity command change bound per step
+  double m_maxChange = 0.0;
+
+  // Solver iterations per solve
+  int m_iterations = DEFAULT_ITERATIONS;
+
+  // Rate weight, scales the previous command in the linear cost
+  double m_rateWeight = 0.0;
+
+  // Position weight
+  double m_positionWeight = 0.0;
+
+  // ADMM penalty
+  double m_rho = 0.0;
+
+  //
+  // Precomputed problem
+  //
+
+  // Predicted positions: free response to position and velocity
+  stateMatrix_t m_free;
+
+  // Predicted positions: forced response to commands
+  matrix_t m_forced;
+
+  // Constraint matrix: identity over difference operator
+  constraintMatrix_t m_constraints;
+
+  // Inverse of the regularized KKT matrix
+  matrix_t m_inverse;
+
+  //
+  // State
+  //
+
+  // Commands, constraint values and scaled duals, kept to warm start the next solve
+  vector_t m_commands;
+  constraintVector_t m_z;
+  constraintVector_t m_y;
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  // Precompute problem for a velocity controlled joint with first order response
+  bool init(
+    double timeConstant,
+    double step,
+    double maxVelocity,
+    double maxAcceleration,
+    double positionWeight,
+    double commandWeight,
+    double rateWeight,
+    int iterations);
+
+  // Forget warm start, call when a new trajectory begins
+  void reset(double command);
+
+  // Solve for the next velocity command given HORIZON reference positions, one per step
+  double solve(double position, double velocity, double lastCommand, const double* reference);
+
+  // Get time between prediction steps
+  inline double getStep() const
+  {
+    return m_step;
+  }
+
+  // Get HORIZON positions predicted by the last solution, one per step
+  void predict(double position, double velocity, double* positions) const;
+};
+
+} // namespace str1ker
@@ -0,0 +1,169 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ mpcTrajectoryController.cpp
+
+ Model Predictive Joint Trajectory Controller
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <pluginlib/class_list_macros.h>
+#include "mpcTrajectoryController.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace std;
+using namespace str1ker;
+
+/*----------------------------------------------------------*\
+| mpcTrajectoryController implementation
+\*----------------------------------------------------------*/
+
+bool mpcTrajectoryController::init(
+  hardware_interface::VelocityJointInterface* hw,
+  ros::NodeHandle& managerNode,
+  ros::NodeHandle& node)
+{
+  if (!jointTrajectoryController::init(hw, managerNode, node)) return false;
+
+  // Load solver settings shared by all joints
+  double step = DEFAULT_STEP;
+  int iterations = DEFAULT_ITERATIONS;
+  double positionWeight = DEFAULT_POSITION_WEIGHT;
+  double commandWeight = DEFAULT_COMMAND_WEIGHT;
+  double rateWeight = DEFAULT_RATE_WEIGHT;
+
+  node.getParam("mpc/step", step);
+  node.getParam("mpc/iterations", iterations);
+  node.getParam("mpc/position_weight", positionWeight);
+  node.getParam("mpc/command_weight", commandWeight);
+  node.getParam("mpc/rate_weight", rateWeight);
+
+  // Load joint models and limits
+  m_solvers.resize(m_joints.size());
+
+  for (size_t jointIndex = 0; jointIndex < m_joints.size(); jointIndex++)
+  {
+    const joint_t& joint = m_joints[jointIndex];
+    string path = "mpc/" + joint.name;
+
+    // Velocity response defaults to the delay compensation plant model
+    double timeConstant = joint.timeConstant;
+    node.getParam(path + "/time_constant", timeConstant);
+
+    // Velocity command is the PWM duty cycle scaled by hardware, so its limit is the PWM limit
+    double maxAcceleration = joint.maxVelocity / DEFAULT_RAMP_TIME;
+    node.getParam(path + "/max_acceleration", maxAcceleration);
+
+    if (!m_solvers[jointIndex].init(
+      timeConstant,
+      step,
+      joint.maxVelocity,
+      maxAcceleration,
+      positionWeight,
+      commandWeight,
+      rateWeight,
+      iterations))
+    {
+      ROS_ERROR_NAMED(
+        m_name.c_str(),
+        "Invalid MPC settings for %s: time constant %g, step %g, acceleration %g, iterations %d",
+        joint.name.c_str(),
+        timeConstant,
+        step,
+        maxAcceleration,
+        iterations
+      );
+
+      return false;
+    }
+
+    ROS_INFO_NAMED(
+      m_name.c_str(),
+      "MPC for %s: %d steps of %g seconds, time constant %g, velocity %g, acceleration %g",
+      joint.name.c_str(),
+      mpcSolver::HORIZON,
+      step,
+      timeConstant,
+      joint.maxVelocity,
+      maxAcceleration
+    );
+  }
+
+  // Allocate preview once, the update loop only overwrites it
+  m_preview.resize(mpcSolver::HORIZON, vector<double>(m_joints.size(), 0.0));
+  m_reference.resize(mpcSolver::HORIZON, 0.0);
+
+  return true;
+}
+
+void mpcTrajectoryController::update(const ros::Time& time, const ros::Duration& period)
+{
+  updateTrajectory(*this, time, period);
+}
+
+double mpcTrajectoryController::computeCommand(
+  joint_t& joint, double trajectoryTime, const ros::Duration& period)
+{
+  size_t jointIndex = &joint - &m_joints.front();
+  mpcSolver& solver = m_solvers[jointIndex];
+
+  // Previous solutions don't warm start a new trajectory
+  if (m_startTime != m_solveStart)
+  {
+    m_solveStart = m_startTime;
+    m_previewTime = -1.0;
+
+    for (mpcSolver& jointSolver : m_solvers)
+    {
+      jointSolver.reset(0.0);
+    }
+  }
+
+  // Sample reference positions once per cycle for all joints
+  if (trajectoryTime != m_previewTime)
+  {
+    samplePreview(trajectoryTime);
+  }
+
+  for (int step = 0; step < mpcSolver::HORIZON; step++)
+  {
+    m_reference[step] = m_preview[step][jointIndex];
+  }
+
+  // Predicted position accounts for delay when compensation is enabled
+  return solver.solve(
+    joint.predicted,
+    joint.handle.getVelocity(),
+    joint.command,
+    m_reference.data()
+  );
+}
+
+void mpcTrajectoryController::samplePreview(double trajectoryTime)
+{
+  m_previewTime = trajectoryTime;
+
+  double step = m_solvers.front().getStep();
+
+  for (int index = 0; index < mpcSolver::HORIZON; index++)
+  {
+    sampleTrajectory(trajectoryTime + step * (index + 1), m_preview[index]);
+  }
+}
+
+PLUGINLIB_EXPORT_CLASS(str1ker::mpcTrajectoryController, controller_interface::ControllerBase);
@@ -0,0 +1,100 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ mpcTrajectoryController.h
+
+ Model Predictive Joint Trajectory Controller
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <vector>
+#include <Eigen/StdVector>
+#include "jointTrajectoryController.h"
+#include "mpcSolver.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| mpcTrajectoryController class
+\*----------------------------------------------------------*/
+
+class mpcTrajectoryController : public jointTrajectoryController
+{
+private:
+  //
+  // Constants
+  //
+
+  const double DEFAULT_STEP = 0.02;
+  const int DEFAULT_ITERATIONS = 40;
+  const double DEFAULT_POSITION_WEIGHT = 1.0;
+  const double DEFAULT_COMMAND_WEIGHT = 0.0;
+  const double DEFAULT_RATE_WEIGHT = 0.001;
+  const double DEFAULT_RAMP_TIME = 0.25;
+
+private:
+  //
+  // Configuration
+  //
+
+  // Solver for each joint, indexed like m_joints
+  std::vector<mpcSolver, Eigen::aligned_allocator<mpcSolver>> m_solvers;
+
+  //
+  // State
+  //
+
+  // Reference positions for all joints at each prediction step
+  std::vector<std::vector<double>> m_preview;
+
+  // Reference positions for one joint over the horizon
+  std::vector<double> m_reference;
+
+  // Trajectory time the preview was sampled at
+  double m_previewTime = -1.0;
+
+  // Trajectory start the solvers were warm started for
+  ros::Time m_solveStart;
+
+public:
+  //
+  // Initialization
+  //
+
+  bool init(velocityHardware* hw, ros::NodeHandle& managerNode, ros::NodeHandle& node);
+
+  //
+  // Lifecycle
+  //
+
+  void update(const ros::Time& time, const ros::Duration& period);
+
+  //
+  // Command law, hides the velocity command law
+  //
+
+  double computeCommand(joint_t& joint, double trajectoryTime, const ros::Duration& period);
+
+private:
+  void samplePreview(double trajectoryTime);
+};
+
+} // namespace str1ker
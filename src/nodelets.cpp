@@ -0,0 +1,109 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ nodelets.cpp
+
+ Nodelets for running hardware, robot and serial transport in one process
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <pluginlib/class_list_macros.h>
+#include "nodelets.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| hardwareNodelet implementation
+\*----------------------------------------------------------*/
+
+hardwareNodelet::~hardwareNodelet()
+{
+  if (!m_thread.joinable()) return;
+
+  m_hardware->shutdown();
+  m_thread.join();
+}
+
+void hardwareNodelet::onInit()
+{
+  // Telemetry, controller manager services and reloads run concurrently
+  m_hardware.reset(new hardware(getMTNodeHandle(), "robot"));
+
+  NODELET_INFO("loading hardware");
+
+  if (!m_hardware->configure() || !m_hardware->init())
+  {
+    NODELET_FATAL("hardware failed to initialize");
+    return;
+  }
+
+  NODELET_INFO("hardware initialized successfully");
+
+  m_thread = thread([this]() { m_hardware->run(false); });
+}
+
+/*----------------------------------------------------------*\
+| robotNodelet implementation
+\*----------------------------------------------------------*/
+
+void robotNodelet::onInit()
+{
+  m_robot.reset(new robot(getNodeHandle()));
+
+  if (!m_robot->configure("robot").init())
+  {
+    NODELET_FATAL("robot failed to initialize");
+    return;
+  }
+
+  m_timer = getNodeHandle().createTimer(
+    ros::Duration(1.0 / m_robot->getRate()),
+    [this](const ros::TimerEvent&) { m_robot->update(); });
+}
+
+/*----------------------------------------------------------*\
+| serialNodelet implementation
+\*----------------------------------------------------------*/
+
+serialNodelet::~serialNodelet()
+{
+  if (!m_thread.joinable()) return;
+
+  m_transport->shutdown();
+  m_thread.join();
+}
+
+void serialNodelet::onInit()
+{
+  // Output requests are written while the read loop blocks on the port
+  m_transport.reset(new serialTransport(getMTNodeHandle(), "serial"));
+
+  if (!m_transport->configure() || !m_transport->init())
+  {
+    NODELET_FATAL("serial transport failed to initialize");
+    return;
+  }
+
+  m_thread = thread([this]() { m_transport->run(); });
+}
+
+PLUGINLIB_EXPORT_CLASS(str1ker::hardwareNodelet, nodelet::Nodelet);
+PLUGINLIB_EXPORT_CLASS(str1ker::robotNodelet, nodelet::Nodelet);
+PLUGINLIB_EXPORT_CLASS(str1ker::serialNodelet, nodelet::Nodelet);
@@ -0,0 +1,94 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ nodelets.h
+
+ Nodelets for running hardware, robot and serial transport in one process
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <memory>
+#include <thread>
+#include <nodelet/nodelet.h>
+#include "hardware.h"
+#include "robot.h"
+#include "serialTransport.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| hardwareNodelet class
+\*----------------------------------------------------------*/
+
+class hardwareNodelet : public nodelet::Nodelet
+{
+private:
+  // Hardware interface
+  std::unique_ptr<hardware> m_hardware;
+
+  // Real-time loop, callbacks are spun by the nodelet manager
+  std::thread m_thread;
+
+public:
+  ~hardwareNodelet();
+
+private:
+  virtual void onInit();
+};
+
+/*----------------------------------------------------------*\
+| robotNodelet class
+\*----------------------------------------------------------*/
+
+class robotNodelet : public nodelet::Nodelet
+{
+private:
+  // Robot controller
+  std::unique_ptr<robot> m_robot;
+
+  // Update timer
+  ros::Timer m_timer;
+
+private:
+  virtual void onInit();
+};
+
+/*----------------------------------------------------------*\
+| serialNodelet class
+\*----------------------------------------------------------*/
+
+class serialNodelet : public nodelet::Nodelet
+{
+private:
+  // Serial transport
+  std::unique_ptr<serialTransport> m_transport;
+
+  // Read loop
+  std::thread m_thread;
+
+public:
+  ~serialNodelet();
+
+private:
+  virtual void onInit();
+};
+
+} // namespace str1ker
@@ -0,0 +1,305 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ observer.cpp
+
+ Joint Disturbance Observer Implementation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <cmath>
+#include "controllerFactory.h"
+#include "controllerUtilities.h"
+#include "hardwareUtilities.h"
+#include "observer.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Constants
+\*----------------------------------------------------------*/
+
+const char observer::TYPE[] = "observer";
+
+/*----------------------------------------------------------*\
+| observer implementation
+\*----------------------------------------------------------*/
+
+REGISTER_CONTROLLER(observer);
+
+//
+// Constructors
+//
+
+observer::observer(ros::NodeHandle node, string path)
+  : controller(node, TYPE, path)
+{
+}
+
+//
+// Configuration
+//
+
+bool observer::configure()
+{
+  controller::configure();
+
+  if (!getSetting("timeConstant", m_timeConstant))
+    ROS_WARN("%s did not specify timeConstant, using %g", getPath().c_str(), m_timeConstant);
+
+  if (!getSetting("gain", m_gain))
+    ROS_WARN("%s did not specify gain, using %g", getPath().c_str(), m_gain);
+
+  if (!getSetting("positionNoise", m_positionNoise))
+    ROS_WARN("%s did not specify positionNoise, using %g", getPath().c_str(), m_positionNoise);
+
+  if (!getSetting("velocityNoise", m_velocityNoise))
+    ROS_WARN("%s did not specify velocityNoise, using %g", getPath().c_str(), m_velocityNoise);
+
+  if (!getSetting("disturbanceNoise", m_disturbanceNoise))
+    ROS_WARN("%s did not specify disturbanceNoise, using %g", getPath().c_str(), m_disturbanceNoise);
+
+  if (!getSetting("feedforward", m_feedforward))
+    ROS_WARN("%s did not specify feedforward, disturbance cancellation disabled", getPath().c_str());
+
+  if (!getSetting("maxFeedforward", m_maxFeedforward))
+    ROS_WARN("%s did not specify maxFeedforward, feedforward not limited", getPath().c_str());
+
+  m_staged.timeConstant = m_timeConstant;
+  m_staged.gain = m_gain;
+  m_staged.positionNoise = m_positionNoise;
+  m_staged.velocityNoise = m_velocityNoise;
+  m_staged.disturbanceNoise = m_disturbanceNoise;
+  m_staged.feedforward = m_feedforward;
+  m_staged.maxFeedforward = m_maxFeedforward;
+
+  return validate(m_staged);
+}
+
+bool observer::validate(const reloadable_t& settings)
+{
+  if (settings.timeConstant <= 0.0)
+  {
+    ROS_ERROR("%s timeConstant must be positive", getPath().c_str());
+    return false;
+  }
+
+  if (utilities::isZero(settings.gain))
+  {
+    ROS_ERROR("%s gain must not be zero", getPath().c_str());
+    return false;
+  }
+
+  if (settings.positionNoise <= 0.0 || settings.velocityNoise < 0.0 || settings.disturbanceNoise < 0.0)
+  {
+    ROS_ERROR("%s noise [%g, %g, %g] is invalid", getPath().c_str(),
+      settings.positionNoise, settings.velocityNoise, settings.disturbanceNoise);
+    return false;
+  }
+
+  if (settings.maxFeedforward < 0.0)
+  {
+    ROS_ERROR("%s maxFeedforward must not be negative", getPath().c_str());
+    return false;
+  }
+
+  return true;
+}
+
+//
+// Initialization
+//
+
+bool observer::init()
+{
+  ROS_INFO("  initialized %s %s: tau %g s, gain %g, noise %g/%g/%g, feedforward %s",
+    getPath().c_str(),
+    getType().c_str(),
+    m_timeConstant,
+    m_gain,
+    m_positionNoise,
+    m_velocityNoise,
+    m_disturbanceNoise,
+    m_feedforward ? "on" : "off");
+
+  return true;
+}
+
+//
+// Reload
+//
+
+bool observer::stage(XmlRpc::XmlRpcValue& settings)
+{
+  reloadable_t staged = m_staged;
+
+  controllerUtilities::getSetting(settings, "timeConstant", staged.timeConstant);
+  controllerUtilities::getSetting(settings, "gain", staged.gain);
+  controllerUtilities::getSetting(settings, "positionNoise", staged.positionNoise);
+  controllerUtilities::getSetting(settings, "velocityNoise", staged.velocityNoise);
+  controllerUtilities::getSetting(settings, "disturbanceNoise", staged.disturbanceNoise);
+  controllerUtilities::getSetting(settings, "feedforward", staged.feedforward);
+  controllerUtilities::getSetting(settings, "maxFeedforward", staged.maxFeedforward);
+
+  if (!validate(staged)) return false;
+
+  m_staged = staged;
+
+  return true;
+}
+
+void observer::release()
+{
+  m_reload.publish(m_staged);
+}
+
+bool observer::commit()
+{
+  reloadable_t reloaded;
+
+  if (!m_reload.consume(reloaded)) return false;
+
+  m_timeConstant = reloaded.timeConstant;
+  m_gain = reloaded.gain;
+  m_positionNoise = reloaded.positionNoise;
+  m_velocityNoise = reloaded.velocityNoise;
+  m_disturbanceNoise = reloaded.disturbanceNoise;
+  m_feedforward = reloaded.feedforward;
+  m_maxFeedforward = reloaded.maxFeedforward;
+
+  return true;
+}
+
+//
+// Estimation
+//
+
+void observer::predict(ros::Duration period)
+{
+  double dt = period.toSec();
+
+  if (!m_ready || dt <= 0.0) return;
+
+  // Exact discretization of v' = (gain * command - v) / tau + disturbance
+  double tau = m_timeConstant;
+  double a = exp(-dt / tau);
+  double b = tau * (1.0 - a);
+  double u = m_gain * m_command;
+
+  double f[STATES][STATES] =
+  {
+    { 1.0, b,   tau * (dt - b) },
+    { 0.0, a,   b              },
+    { 0.0, 0.0, 1.0            }
+  };
+
+  double x[STATES] =
+  {
+    m_x[0] + b * m_x[1] + tau * (dt - b) * m_x[2] + (dt - b) * u,
+    a * m_x[1] + b * m_x[2] + (1.0 - a) * u,
+    m_x[2]
+  };
+
+  // P = F * P * F' + Q
+  double fp[STATES][STATES] = {};
+
+  for (int i = 0; i < STATES; i++)
+    for (int j = 0; j < STATES; j++)
+      for (int k = 0; k < STATES; k++)
+        fp[i][j] += f[i][k] * m_p[k][j];
+
+  for (int i = 0; i < STATES; i++)
+  {
+    for (int j = 0; j < STATES; j++)
+    {
+      double sum = 0.0;
+
+      for (int k = 0; k < STATES; k++)
+        sum += fp[i][k] * f[j][k];
+
+      m_p[i][j] = sum;
+    }
+
+    m_x[i] = x[i];
+  }
+
+  m_p[1][1] += m_velocityNoise * m_velocityNoise * dt;
+  m_p[2][2] += m_disturbanceNoise * m_disturbanceNoise * dt;
+}
+
+void observer::correct(double position, uint32_t samples)
+{
+  m_samples = samples;
+
+  if (!m_ready)
+  {
+    // Start at rest from the first sample, disturbance unknown
+    m_x[0] = position;
+    m_x[1] = 0.0;
+    m_x[2] = 0.0;
+
+    for (int i = 0; i < STATES; i++)
+      for (int j = 0; j < STATES; j++)
+        m_p[i][j] = 0.0;
+
+    m_p[0][0] = m_positionNoise * m_positionNoise;
+    m_p[1][1] = m_velocityNoise * m_velocityNoise;
+    m_p[2][2] = m_disturbanceNoise * m_disturbanceNoise;
+
+    m_ready = true;
+    return;
+  }
+
+  // Only position is measured, so the gain is the first column of P
+  double innovation = position - m_x[0];
+  double s = m_p[0][0] + m_positionNoise * m_positionNoise;
+  double k[STATES] = { m_p[0][0] / s, m_p[1][0] / s, m_p[2][0] / s };
+  double row[STATES] = { m_p[0][0], m_p[0][1], m_p[0][2] };
+
+  for (int i = 0; i < STATES; i++)
+  {
+    m_x[i] += k[i] * innovation;
+
+    for (int j = 0; j < STATES; j++)
+      m_p[i][j] -= k[i] * row[j];
+  }
+}
+
+double observer::getFeedforward() const
+{
+  if (!m_enable || !m_ready || !m_feedforward) return 0.0;
+
+  // Steady state velocity command offset that cancels disturbance acceleration
+  double feedforward = -m_timeConstant * m_x[2] / m_gain;
+
+  if (m_maxFeedforward > 0.0)
+    feedforward = utilities::clamp(feedforward, -m_maxFeedforward, m_maxFeedforward);
+
+  return feedforward;
+}
+
+//
+// Dynamic creation
+//
+
+controller* observer::create(ros::NodeHandle node, string path)
+{
+  return new observer(node, path);
+}
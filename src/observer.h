@@ -0,0 +1,199 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ observer.h
+
+ Joint Disturbance Observer class
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <ros/ros.h>
+#include "controller.h"
+#include "configSnapshot.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| observer class
+\*----------------------------------------------------------*/
+
+class observer : public controller
+{
+public:
+  // Controller type
+  static const char TYPE[];
+
+private:
+  // State size: position, velocity, disturbance
+  static const int STATES = 3;
+
+  // Default actuator velocity response time constant in seconds
+  const double DEFAULT_TIME_CONSTANT = 0.05;
+
+  // Default measurement noise in position units
+  const double DEFAULT_POSITION_NOISE = 0.01;
+
+  // Default process noise on velocity in velocity units per root second
+  const double DEFAULT_VELOCITY_NOISE = 0.1;
+
+  // Default process noise on disturbance in acceleration units per root second
+  const double DEFAULT_DISTURBANCE_NOISE = 1.0;
+
+  // Settings that can be reloaded while running
+  struct reloadable_t
+  {
+    double timeConstant;
+    double gain;
+    double positionNoise;
+    double velocityNoise;
+    double disturbanceNoise;
+    bool feedforward;
+    double maxFeedforward;
+  };
+
+private:
+  //
+  // Configuration
+  //
+
+  // Time for velocity to reach 63% of a step in velocity command
+  double m_timeConstant = DEFAULT_TIME_CONSTANT;
+
+  // Steady state velocity per unit of velocity command
+  double m_gain = 1.0;
+
+  // Standard deviation of encoder position samples
+  double m_positionNoise = DEFAULT_POSITION_NOISE;
+
+  // Unmodeled velocity change rate
+  double m_velocityNoise = DEFAULT_VELOCITY_NOISE;
+
+  // Load disturbance change rate
+  double m_disturbanceNoise = DEFAULT_DISTURBANCE_NOISE;
+
+  // Whether to cancel estimated disturbance in the velocity command
+  bool m_feedforward = false;
+
+  // Max feedforward added to velocity command (0 for unlimited)
+  double m_maxFeedforward = 0.0;
+
+  // Settings staged by reload, owned by reload thread
+  reloadable_t m_staged;
+
+  // Settings handed from reload thread to update loop
+  configSnapshot<reloadable_t> m_reload;
+
+  //
+  // State
+  //
+
+  // Initialized from the first position sample
+  bool m_ready = false;
+
+  // Estimated position, velocity and disturbance acceleration
+  double m_x[STATES] = { 0.0, 0.0, 0.0 };
+
+  // Estimate covariance
+  double m_p[STATES][STATES] = {};
+
+  // Last velocity command sent to the actuator
+  double m_command = 0.0;
+
+  // Encoder sample count at last correction
+  uint32_t m_samples = 0;
+
+public:
+  //
+  // Constructors
+  //
+
+  observer(ros::NodeHandle node, std::string path);
+
+public:
+  // Get estimated position
+  inline double getPos() const
+  {
+    return m_x[0];
+  }
+
+  // Get estimated velocity
+  inline double getVelocity() const
+  {
+    return m_x[1];
+  }
+
+  // Get estimated load disturbance as acceleration
+  inline double getDisturbance() const
+  {
+    return m_x[2];
+  }
+
+  // Determine if the observer has been initialized with a position sample
+  inline bool isReady() const
+  {
+    return m_ready;
+  }
+
+  // Determine if the encoder produced a sample since last correction
+  inline bool isNewSample(uint32_t samples) const
+  {
+    return samples != m_samples;
+  }
+
+  // Record velocity command sent to the actuator for next prediction
+  inline void setCommand(double command)
+  {
+    m_command = command;
+  }
+
+  // Configuration
+  virtual bool configure();
+
+  // Initialization
+  virtual bool init();
+
+  // Validate reloaded settings and keep them staged
+  virtual bool stage(XmlRpc::XmlRpcValue& settings);
+
+  // Hand staged settings to update loop
+  virtual void release();
+
+  // Apply released settings
+  virtual bool commit();
+
+  // Check that settings describe a stable observer
+  bool validate(const reloadable_t& settings);
+
+  // Advance estimate by the plant model driven by last command
+  void predict(ros::Duration period);
+
+  // Correct estimate with an encoder position sample
+  void correct(double position, uint32_t samples);
+
+  // Get velocity command that cancels estimated disturbance
+  double getFeedforward() const;
+
+public:
+  // Create instance
+  static controller* create(ros::NodeHandle node, std::string path);
+};
+
+} // namespace str1ker
@@ -0,0 +1,219 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ plant.cpp
+
+ Simulated Joint Dynamics
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <cmath>
+#include "controllerUtilities.h"
+#include "hardwareUtilities.h"
+#include "hardware.h"
+#include "plant.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| plant implementation
+\*----------------------------------------------------------*/
+
+plant::plant()
+  : m_readings(new Adc())
+  , m_noise(0)
+  , m_seed(0)
+{
+}
+
+//
+// Configuration
+//
+
+bool plant::configure(hardware& hw, XmlRpc::XmlRpcValue& settings)
+{
+  controllerUtilities::getSetting(settings, "noise", m_noise);
+
+  int seed = 0;
+  controllerUtilities::getSetting(settings, "seed", seed);
+  m_seed = unsigned(seed);
+
+  XmlRpc::XmlRpcValue joints;
+  controllerUtilities::getSubtree(settings, "joints", joints);
+
+  m_joints.clear();
+
+  for (auto controller: hw.getControllers())
+  {
+    if (controller->getType() != motor::TYPE) continue;
+
+    joint_t joint;
+    joint.name = controller->getParentName();
+    joint.actuator = dynamic_cast<motor*>(controller.get());
+    joint.sensor = NULL;
+
+    for (auto sibling: hw.getControllers())
+    {
+      if (sibling->getType() == encoder::TYPE && sibling->getParentName() == joint.name)
+        joint.sensor = dynamic_cast<encoder*>(sibling.get());
+    }
+
+    if (!joint.sensor)
+    {
+      ROS_WARN("%s has no encoder, not simulated", joint.name.c_str());
+      continue;
+    }
+
+    // End stops at encoder range unless narrower limits are loaded
+    auto limits = hw.getLimits(joint.name);
+    joint.minPos = joint.sensor->getMin();
+    joint.maxPos = joint.sensor->getMax();
+
+    if (limits.has_position_limits)
+    {
+      joint.minPos = max(joint.minPos, limits.min_position);
+      joint.maxPos = min(joint.maxPos, limits.max_position);
+    }
+
+    joint.timeConstant = DEFAULT_TIME_CONSTANT;
+    joint.gain = 1.0;
+    joint.start = (joint.minPos + joint.maxPos) / 2.0;
+
+    XmlRpc::XmlRpcValue jointSettings;
+
+    if (controllerUtilities::getSubtree(joints, joint.name, jointSettings))
+    {
+      controllerUtilities::getSetting(jointSettings, "timeConstant", joint.timeConstant);
+      controllerUtilities::getSetting(jointSettings, "gain", joint.gain);
+      controllerUtilities::getSetting(jointSettings, "start", joint.start);
+    }
+
+    if (joint.timeConstant <= 0.0)
+    {
+      ROS_ERROR("%s plant time constant %g must be positive", joint.name.c_str(), joint.timeConstant);
+      return false;
+    }
+
+    m_joints.push_back(joint);
+  }
+
+  m_readings->adc.resize(ADC_CHANNELS);
+  m_readings->quadrature.resize(QUADRATURE_CHANNELS);
+  m_readings->velocity.resize(QUADRATURE_CHANNELS);
+
+  reset();
+
+  return true;
+}
+
+void plant::reset()
+{
+  for (joint_t& joint : m_joints)
+  {
+    joint.pos = utilities::clamp(joint.start, joint.minPos, joint.maxPos);
+    joint.vel = 0.0;
+  }
+
+  m_random.seed(m_seed);
+}
+
+//
+// Simulation
+//
+
+const Adc::Ptr& plant::sample()
+{
+  for (const joint_t& joint : m_joints)
+  {
+    const encoder* sensor = joint.sensor;
+
+    // Joint position -> analog reading, inverse of encoder mapping
+    double readingsPerUnit = double(sensor->getMaxReading() - sensor->getMinReading()) /
+      (sensor->getMax() - sensor->getMin());
+
+    double reading = sensor->getMinReading() + (joint.pos - sensor->getMin()) * readingsPerUnit;
+
+    if (m_noise > 0)
+      reading += int(m_random() % unsigned(2 * m_noise + 1)) - m_noise;
+
+    int channel = sensor->getAbsoluteChannel();
+
+    if (channel >= 0 && channel < ADC_CHANNELS)
+      m_readings->adc[channel] = int16_t(lround(reading));
+
+    // Analog reading -> quadrature counts, inverse of quadrature scale
+    channel = sensor->getQuadratureChannel();
+
+    if (channel >= 0 && channel < QUADRATURE_CHANNELS && sensor->getQuadratureScale() != 0.0)
+    {
+      double countsPerReading = 1.0 / sensor->getQuadratureScale();
+
+      m_readings->quadrature[channel] = int32_t(lround(
+        (joint.pos - sensor->getMin()) * readingsPerUnit * countsPerReading));
+
+      m_readings->velocity[channel] = float(joint.vel * readingsPerUnit * countsPerReading);
+    }
+  }
+
+  return m_readings;
+}
+
+void plant::step(double period)
+{
+  for (joint_t& joint : m_joints)
+  {
+    // Exact first-order response over the period
+    double target = getTargetVelocity(joint);
+    double decay = exp(-period / joint.timeConstant);
+    double vel = target + (joint.vel - target) * decay;
+
+    // Integrate average velocity over the period
+    double travel = target * period + (joint.vel - target) * joint.timeConstant * (1.0 - decay);
+    double pos = joint.pos + travel;
+
+    // End stops absorb velocity
+    if (pos <= joint.minPos || pos >= joint.maxPos)
+    {
+      pos = utilities::clamp(pos, joint.minPos, joint.maxPos);
+      vel = 0.0;
+    }
+
+    joint.pos = pos;
+    joint.vel = vel;
+  }
+}
+
+double plant::getTargetVelocity(const joint_t& joint) const
+{
+  const motor* actuator = joint.actuator;
+  int duty = joint.actuator->getRPWM() - joint.actuator->getLPWM();
+
+  if (!duty || actuator->getMaxPwm() == actuator->getMinPwm()) return 0.0;
+
+  // Inverse of motor velocity to PWM mapping
+  double speed = utilities::map(
+    double(abs(duty)),
+    double(actuator->getMinPwm()),
+    double(actuator->getMaxPwm()),
+    actuator->getMinVelocity(),
+    actuator->getMaxVelocity());
+
+  return (duty > 0 ? speed : -speed) * joint.gain;
+}
@@ -0,0 +1,148 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ plant.h
+
+ Simulated Joint Dynamics
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <xmlrpcpp/XmlRpcValue.h>
+#include <str1ker/Adc.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| Declarations
+\*----------------------------------------------------------*/
+
+class hardware;
+class motor;
+class encoder;
+
+/*----------------------------------------------------------*\
+| plant class
+\*----------------------------------------------------------*/
+
+class plant
+{
+private:
+  // Default time for joint velocity to reach 63% of commanded velocity
+  const double DEFAULT_TIME_CONSTANT = 0.05;
+
+  // Number of analog channels published by the device
+  const int ADC_CHANNELS = 16;
+
+  // Number of quadrature channels published by the device
+  const int QUADRATURE_CHANNELS = 4;
+
+  // Simulated joint driven by a motor and measured by an encoder
+  struct joint_t
+  {
+    std::string name;
+
+    // Actuator and sensor configured by hardware
+    motor* actuator;
+    encoder* sensor;
+
+    // First-order velocity response
+    double timeConstant;
+
+    // Velocity gain relative to the motor mapping, models a weak or strong actuator
+    double gain;
+
+    // End stops
+    double minPos;
+    double maxPos;
+
+    // Initial position
+    double start;
+
+    // State
+    double pos;
+    double vel;
+  };
+
+private:
+  // Simulated joints
+  std::vector<joint_t> m_joints;
+
+  // Readings handed to hardware, reused every step
+  Adc::Ptr m_readings;
+
+  // Analog reading noise amplitude
+  int m_noise;
+
+  // Seed for reading noise
+  unsigned int m_seed;
+
+  // Noise generator, seeded so runs repeat exactly
+  std::mt19937 m_random;
+
+public:
+  plant();
+
+public:
+  // Find motors and encoders of each joint and load plant settings
+  bool configure(hardware& hw, XmlRpc::XmlRpcValue& settings);
+
+  // Move joints to start positions and restart noise sequence
+  void reset();
+
+  // Produce device readings for current joint state
+  const Adc::Ptr& sample();
+
+  // Advance joint state by period under current PWM outputs
+  void step(double period);
+
+  // Get simulated joint count
+  inline size_t getJointCount() const
+  {
+    return m_joints.size();
+  }
+
+  // Get simulated joint name
+  inline const std::string& getJointName(size_t joint) const
+  {
+    return m_joints[joint].name;
+  }
+
+  // Get simulated joint position
+  inline double getPos(size_t joint) const
+  {
+    return m_joints[joint].pos;
+  }
+
+  // Get simulated joint velocity
+  inline double getVelocity(size_t joint) const
+  {
+    return m_joints[joint].vel;
+  }
+
+private:
+  // Convert PWM outputs to velocity the actuator would reach
+  double getTargetVelocity(const joint_t& joint) const;
+};
+
+} // namespace str1ker
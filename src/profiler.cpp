@@ -0,0 +1,191 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ profiler.cpp
+
+ Hardware performance counters for update loop phases
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <chrono>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "profiler.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Definitions
+\*----------------------------------------------------------*/
+
+static const char* PHASE_NAMES[profiler::PHASES] =
+{
+  "reload",
+  "read",
+  "controllers",
+  "control",
+  "limits",
+  "write",
+  "publish"
+};
+
+static const char* COUNTER_NAMES[profiler::COUNTERS] =
+{
+  "cycles",
+  "instructions",
+  "cache misses",
+  "context switches"
+};
+
+// No glibc wrapper for perf_event_open
+static int perfEventOpen(perf_event_attr& attr, int group)
+{
+  return int(syscall(__NR_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+/*----------------------------------------------------------*\
+| profiler implementation
+\*----------------------------------------------------------*/
+
+profiler::profiler()
+  : m_leader(-1)
+  , m_opened(0)
+  , m_lastTime(0)
+{
+  for (int counter = 0; counter < COUNTERS; counter++)
+  {
+    m_fd[counter] = -1;
+    m_index[counter] = -1;
+    m_last[counter] = 0;
+  }
+
+  memset(m_totals, 0, sizeof(m_totals));
+}
+
+profiler::~profiler()
+{
+  close();
+}
+
+bool profiler::open()
+{
+  close();
+
+  openCounter(CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  openCounter(INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  openCounter(CACHE_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  openCounter(CONTEXT_SWITCHES, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+
+  if (m_leader == -1) return false;
+
+  ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+  return true;
+}
+
+void profiler::close()
+{
+  for (int counter = 0; counter < COUNTERS; counter++)
+  {
+    if (m_fd[counter] != -1) ::close(m_fd[counter]);
+
+    m_fd[counter] = -1;
+    m_index[counter] = -1;
+  }
+
+  m_leader = -1;
+  m_opened = 0;
+}
+
+bool profiler::openCounter(counter_t counter, uint32_t type, uint64_t config)
+{
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.disabled = m_leader == -1;
+  attr.exclude_hv = 1;
+
+  int fd = perfEventOpen(attr, m_leader);
+
+  if (fd == -1)
+  {
+    // Kernel events require perf_event_paranoid below 2 or CAP_PERFMON
+    attr.exclude_kernel = 1;
+    fd = perfEventOpen(attr, m_leader);
+  }
+
+  if (fd == -1) return false;
+
+  if (m_leader == -1) m_leader = fd;
+
+  m_fd[counter] = fd;
+  m_index[counter] = m_opened++;
+
+  return true;
+}
+
+void profiler::sample(phase_t phase)
+{
+  uint64_t now = chrono::duration_cast<chrono::nanoseconds>(
+    chrono::steady_clock::now().time_since_epoch()).count();
+
+  ssize_t size = sizeof(uint64_t) * (1 + m_opened);
+  bool valid = read(m_leader, m_buffer, size) == size;
+
+  if (phase != PHASES)
+  {
+    totals_t& totals = m_totals[phase];
+
+    totals.samples++;
+    totals.time += now - m_lastTime;
+
+    for (int counter = 0; counter < COUNTERS && valid; counter++)
+    {
+      if (m_index[counter] == -1) continue;
+      totals.counters[counter] += m_buffer[1 + m_index[counter]] - m_last[counter];
+    }
+  }
+
+  m_lastTime = now;
+
+  for (int counter = 0; counter < COUNTERS && valid; counter++)
+  {
+    if (m_index[counter] == -1) continue;
+    m_last[counter] = m_buffer[1 + m_index[counter]];
+  }
+}
+
+const char* profiler::getPhaseName(phase_t phase)
+{
+  return PHASE_NAMES[phase];
+}
+
+const char* profiler::getCounterName(counter_t counter)
+{
+  return COUNTER_NAMES[counter];
+}
@@ -0,0 +1,153 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ profiler.h
+
+ Hardware performance counters for update loop phases
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <cstdint>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| profiler class
+\*----------------------------------------------------------*/
+
+class profiler
+{
+public:
+  // Update loop phases, in the order they run
+  enum phase_t
+  {
+    RELOAD,
+    READ,
+    CONTROLLERS,
+    CONTROL,
+    LIMITS,
+    WRITE,
+    PUBLISH,
+    PHASES
+  };
+
+  // Counters read for each phase
+  enum counter_t
+  {
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_MISSES,
+    CONTEXT_SWITCHES,
+    COUNTERS
+  };
+
+  // Cumulative counts for one phase
+  struct totals_t
+  {
+    // Number of times the phase ran
+    uint64_t samples;
+
+    // Wall time in nanoseconds
+    uint64_t time;
+
+    // Counter values, zero for counters that could not be opened
+    uint64_t counters[COUNTERS];
+  };
+
+private:
+  // Counter file descriptors, -1 if not available
+  int m_fd[COUNTERS];
+
+  // Group leader read for all counters at once, -1 if profiling disabled
+  int m_leader;
+
+  // Position of each counter in group reads
+  int m_index[COUNTERS];
+
+  // Number of counters in the group
+  int m_opened;
+
+  // Group read buffer: counter count followed by values
+  uint64_t m_buffer[1 + COUNTERS];
+
+  // Counter values and time at the end of the last phase
+  uint64_t m_last[COUNTERS];
+  uint64_t m_lastTime;
+
+  // Cumulative counts for each phase
+  totals_t m_totals[PHASES];
+
+public:
+  profiler();
+  ~profiler();
+
+public:
+  // Open counters for the calling thread, returns false if none are available
+  bool open();
+
+  // Close counters
+  void close();
+
+  // Determine if counters are open
+  inline bool isOpen() const
+  {
+    return m_leader != -1;
+  }
+
+  // Determine if a counter is available
+  inline bool isAvailable(counter_t counter) const
+  {
+    return m_fd[counter] != -1;
+  }
+
+  // Start measuring the first phase of a cycle
+  inline void begin()
+  {
+    if (m_leader != -1) sample(PHASES);
+  }
+
+  // Attribute counts since the last phase to this phase
+  inline void end(phase_t phase)
+  {
+    if (m_leader != -1) sample(phase);
+  }
+
+  // Get cumulative counts for a phase
+  inline const totals_t& getTotals(phase_t phase) const
+  {
+    return m_totals[phase];
+  }
+
+  // Get phase name for publishing
+  static const char* getPhaseName(phase_t phase);
+
+  // Get counter name for logging
+  static const char* getCounterName(counter_t counter);
+
+private:
+  // Read counters and add the difference to a phase, or only read if PHASES
+  void sample(phase_t phase);
+
+  // Open one counter in the group
+  bool openCounter(counter_t counter, uint32_t type, uint64_t config);
+};
+
+} // namespace str1ker
@@ -0,0 +1,307 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ recorder.cpp
+
+ Hardware I/O Recording
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "recorder.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Definitions
+\*----------------------------------------------------------*/
+
+// Round record size up to keep headers aligned
+static inline size_t align(size_t size)
+{
+  return (size + 7) & ~size_t(7);
+}
+
+/*----------------------------------------------------------*\
+| Variables
+\*----------------------------------------------------------*/
+
+const char recorder::MAGIC[8] = { 'S', '1', 'K', 'R', 'L', 'O', 'G', '\0' };
+atomic<bool> recorder::s_enabled(false);
+atomic<int> recorder::s_writers(0);
+int recorder::s_file = -1;
+uint8_t* recorder::s_data = NULL;
+size_t recorder::s_capacity = 0;
+atomic<size_t> recorder::s_offset(0);
+atomic<uint64_t> recorder::s_dropped(0);
+
+/*----------------------------------------------------------*\
+| recorder implementation
+\*----------------------------------------------------------*/
+
+//
+// Lifecycle
+//
+
+bool recorder::open(const string& path, size_t capacity)
+{
+  close();
+
+  capacity = align(max(capacity, sizeof(fileHeader_t)));
+
+  s_file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (s_file < 0) return false;
+
+  // Reserve the whole log so the update loop never grows the file
+  if (ftruncate(s_file, capacity) != 0)
+  {
+    ::close(s_file);
+    s_file = -1;
+    return false;
+  }
+
+  void* data = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, s_file, 0);
+
+  if (data == MAP_FAILED)
+  {
+    ::close(s_file);
+    s_file = -1;
+    return false;
+  }
+
+  s_data = static_cast<uint8_t*>(data);
+  s_capacity = capacity;
+
+  // Fault pages in before the update loop touches them
+  madvise(s_data, s_capacity, MADV_WILLNEED);
+
+  fileHeader_t* header = reinterpret_cast<fileHeader_t*>(s_data);
+  memcpy(header->magic, MAGIC, sizeof(MAGIC));
+  header->version = VERSION;
+  header->reserved = 0;
+  header->steadyStart = now();
+  header->rosStart = int64_t(ros::Time::now().toNSec());
+
+  s_offset = sizeof(fileHeader_t);
+  s_dropped = 0;
+  s_enabled = true;
+
+  return true;
+}
+
+bool recorder::close()
+{
+  if (!s_data) return false;
+
+  s_enabled = false;
+
+  // Let writers that passed the enabled check finish
+  while (s_writers.load()) this_thread::yield();
+
+  size_t used = min(s_offset.load(), s_capacity);
+
+  munmap(s_data, s_capacity);
+  s_data = NULL;
+
+  // Trim reserved space past the last record
+  bool trimmed = ftruncate(s_file, used) == 0;
+
+  ::close(s_file);
+  s_file = -1;
+
+  return trimmed;
+}
+
+int64_t recorder::now()
+{
+  return chrono::duration_cast<chrono::nanoseconds>(
+    chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//
+// Recording
+//
+
+void recorder::write(recordType type, const void* data, uint32_t size)
+{
+  if (!isEnabled()) return;
+
+  recordHeader_t* header = claim(type, size);
+  if (!header) return;
+
+  memcpy(header + 1, data, size);
+
+  commit(header, size);
+}
+
+recorder::recordHeader_t* recorder::claim(recordType type, uint32_t size)
+{
+  s_writers++;
+
+  if (!s_enabled)
+  {
+    s_writers--;
+    return NULL;
+  }
+
+  size_t length = align(sizeof(recordHeader_t) + size);
+  size_t offset = s_offset.fetch_add(length, memory_order_relaxed);
+
+  if (offset + length > s_capacity)
+  {
+    s_dropped.fetch_add(1, memory_order_relaxed);
+    s_writers--;
+    return NULL;
+  }
+
+  recordHeader_t* header = reinterpret_cast<recordHeader_t*>(s_data + offset);
+  header->type = type;
+  header->reserved = 0;
+  header->time = now();
+
+  return header;
+}
+
+void recorder::commit(recordHeader_t* header, uint32_t size)
+{
+  // Size is written last so a reader never sees a partial record
+  __atomic_store_n(&header->size, size, __ATOMIC_RELEASE);
+
+  s_writers--;
+}
+
+uint64_t recorder::getDropped()
+{
+  return s_dropped.load(memory_order_relaxed);
+}
+
+size_t recorder::getSize()
+{
+  return min(s_offset.load(memory_order_relaxed), s_capacity);
+}
+
+/*----------------------------------------------------------*\
+| recordReader implementation
+\*----------------------------------------------------------*/
+
+recordReader::recordReader()
+  : m_file(-1)
+  , m_data(NULL)
+  , m_size(0)
+  , m_offset(0)
+{
+  memset(&m_header, 0, sizeof(m_header));
+}
+
+recordReader::~recordReader()
+{
+  close();
+}
+
+bool recordReader::open(const string& path)
+{
+  close();
+
+  m_file = ::open(path.c_str(), O_RDONLY);
+  if (m_file < 0) return false;
+
+  struct stat info;
+
+  if (fstat(m_file, &info) != 0 || size_t(info.st_size) < sizeof(recorder::fileHeader_t))
+  {
+    close();
+    return false;
+  }
+
+  void* data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+
+  if (data == MAP_FAILED)
+  {
+    close();
+    return false;
+  }
+
+  m_data = static_cast<const uint8_t*>(data);
+  m_size = info.st_size;
+  m_offset = sizeof(recorder::fileHeader_t);
+
+  memcpy(&m_header, m_data, sizeof(m_header));
+
+  if (memcmp(m_header.magic, recorder::MAGIC, sizeof(recorder::MAGIC)) != 0 ||
+      m_header.version != recorder::VERSION)
+  {
+    close();
+    return false;
+  }
+
+  // Read sequentially, ahead of replay
+  madvise(const_cast<uint8_t*>(m_data), m_size, MADV_SEQUENTIAL);
+
+  return true;
+}
+
+void recordReader::close()
+{
+  if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+  if (m_file >= 0) ::close(m_file);
+
+  m_data = NULL;
+  m_file = -1;
+  m_size = 0;
+  m_offset = 0;
+}
+
+bool recordReader::next(
+  recorder::recordType& type, int64_t& time, const uint8_t*& payload, uint32_t& size)
+{
+  if (!m_data || m_offset + sizeof(recorder::recordHeader_t) > m_size)
+    return false;
+
+  const recorder::recordHeader_t* header =
+    reinterpret_cast<const recorder::recordHeader_t*>(m_data + m_offset);
+
+  size_t length = align(sizeof(recorder::recordHeader_t) + header->size);
+
+  // Unfinished record or end of log
+  if (!header->size) return false;
+  if (m_offset + length > m_size) return false;
+
+  type = recorder::recordType(header->type);
+  time = header->time;
+  payload = reinterpret_cast<const uint8_t*>(header + 1);
+  size = header->size;
+
+  m_offset += length;
+
+  return true;
+}
+
+ros::Time recordReader::getTime(int64_t time) const
+{
+  ros::Time result;
+  result.fromNSec(uint64_t(m_header.rosStart + (time - m_header.steadyStart)));
+  return result;
+}
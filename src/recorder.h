@@ -0,0 +1,219 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ recorder.h
+
+ Hardware I/O Recording
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <ros/time.h>
+#include <ros/serialization.h>
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| recorder class
+\*----------------------------------------------------------*/
+
+class recorder
+{
+public:
+  // Record types
+  enum recordType : uint16_t
+  {
+    // Device readings (str1ker/Adc)
+    ADC = 1,
+
+    // Output requests sent to device (str1ker/Pwm)
+    PWM = 2,
+
+    // Update cycle time and joint commands
+    CYCLE = 3
+  };
+
+  // Start of log file
+  struct fileHeader_t
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+
+    // Monotonic and ROS time when recording started, in nanoseconds
+    int64_t steadyStart;
+    int64_t rosStart;
+  };
+
+  // Start of each record, followed by payload padded to 8 bytes
+  struct recordHeader_t
+  {
+    // Payload size, written last, 0 marks the end of the log
+    uint32_t size;
+    uint16_t type;
+    uint16_t reserved;
+
+    // Monotonic time in nanoseconds
+    int64_t time;
+  };
+
+  // File signature
+  static const char MAGIC[8];
+
+  // File format version
+  static const uint32_t VERSION = 1;
+
+private:
+  // Whether records are written
+  static std::atomic<bool> s_enabled;
+
+  // Writers between enabled check and commit
+  static std::atomic<int> s_writers;
+
+  // Mapped log file
+  static int s_file;
+  static uint8_t* s_data;
+  static size_t s_capacity;
+
+  // Offset of next record to claim
+  static std::atomic<size_t> s_offset;
+
+  // Records that did not fit
+  static std::atomic<uint64_t> s_dropped;
+
+public:
+  // Create log file and map it, capacity is reserved up front
+  static bool open(const std::string& path, size_t capacity);
+
+  // Wait for writers, unmap and trim the log file, returns false if not trimmed
+  static bool close();
+
+  // Determine if records are written
+  static inline bool isEnabled()
+  {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  // Get monotonic time in nanoseconds
+  static int64_t now();
+
+  // Append a ROS message serialized directly into the log
+  template<class M> static void write(recordType type, const M& msg)
+  {
+    if (!isEnabled()) return;
+
+    uint32_t size = ros::serialization::serializationLength(msg);
+    recordHeader_t* header = claim(type, size);
+    if (!header) return;
+
+    ros::serialization::OStream stream(reinterpret_cast<uint8_t*>(header + 1), size);
+    ros::serialization::serialize(stream, msg);
+
+    commit(header, size);
+  }
+
+  // Append raw bytes, size must not be 0
+  static void write(recordType type, const void* data, uint32_t size);
+
+  // Get number of records that did not fit
+  static uint64_t getDropped();
+
+  // Get bytes used
+  static size_t getSize();
+
+private:
+  // Reserve space for a record, returns NULL if disabled or full
+  static recordHeader_t* claim(recordType type, uint32_t size);
+
+  // Publish filled record
+  static void commit(recordHeader_t* header, uint32_t size);
+};
+
+/*----------------------------------------------------------*\
+| recordReader class
+\*----------------------------------------------------------*/
+
+class recordReader
+{
+private:
+  // Mapped log file
+  int m_file;
+  const uint8_t* m_data;
+  size_t m_size;
+
+  // Offset of next record
+  size_t m_offset;
+
+  // File header
+  recorder::fileHeader_t m_header;
+
+public:
+  recordReader();
+  ~recordReader();
+
+public:
+  // Map log file read-only
+  bool open(const std::string& path);
+
+  // Unmap log file
+  void close();
+
+  // Get next record, returns false at end of log
+  bool next(recorder::recordType& type, int64_t& time, const uint8_t*& payload, uint32_t& size);
+
+  // Get next record of a type as a ROS message, returns false at end of log or if corrupted
+  template<class M> bool next(recorder::recordType type, M& msg)
+  {
+    recorder::recordType recordType;
+    int64_t time;
+    const uint8_t* payload;
+    uint32_t size;
+
+    while (next(recordType, time, payload, size))
+    {
+      if (recordType == type) return read(payload, size, msg);
+    }
+
+    return false;
+  }
+
+  // Convert record time to ROS time at recording
+  ros::Time getTime(int64_t time) const;
+
+  // Deserialize ROS message from record payload
+  template<class M> static bool read(const uint8_t* payload, uint32_t size, M& msg)
+  {
+    try
+    {
+      ros::serialization::IStream stream(const_cast<uint8_t*>(payload), size);
+      ros::serialization::deserialize(stream, msg);
+      return true;
+    }
+    catch (ros::serialization::StreamOverrunException&)
+    {
+      return false;
+    }
+  }
+};
+
+} // namespace str1ker
@@ -92,27 +92,3 @@ robot& robot::logo()
 
     return *this;
 }
-
-/*----------------------------------------------------------*\
-| Module entry point
-\*----------------------------------------------------------*/
-
-int main(int argc, char** argv)
-{
-    ros::init(argc, argv, "robot");
-
-    ros::NodeHandle node;
-    robot robot(node);
-
-    if (!robot
-        .logo()
-        .configure("robot")
-        .init())
-    {
-        return 1;
-    }
-
-    robot.run();
-
-    return 0;
-}
@@ -50,6 +50,12 @@ public:
     // Get current node
     ros::NodeHandle getNode();
 
+    // Get spin rate
+    inline double getRate() const
+    {
+        return m_rate;
+    }
+
     // Load controller settings
     robot& configure(const char* nameSpace);
 
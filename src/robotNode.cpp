@@ -0,0 +1,54 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ robotNode.cpp
+
+ Robot Controller Node
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <ros/ros.h>
+#include "robot.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Module entry point
+\*----------------------------------------------------------*/
+
+int main(int argc, char** argv)
+{
+    ros::init(argc, argv, "robot");
+
+    ros::NodeHandle node;
+    robot robot(node);
+
+    if (!robot
+        .logo()
+        .configure("robot")
+        .init())
+    {
+        return 1;
+    }
+
+    robot.run();
+
+    return 0;
+}
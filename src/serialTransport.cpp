@@ -0,0 +1,365 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ serialTransport.cpp
+
+ Serial transport for device readings and output requests
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <ros/serialization.h>
+#include "analog/core/messages.h"
+#include "controllerUtilities.h"
+#include "serialTransport.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Helpers
+\*----------------------------------------------------------*/
+
+// Convert serial speed to termios constant, 0 if not supported
+static speed_t getSpeed(int baud)
+{
+  switch (baud)
+  {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    default: return 0;
+  }
+}
+
+/*----------------------------------------------------------*\
+| serialTransport implementation
+\*----------------------------------------------------------*/
+
+serialTransport::serialTransport(ros::NodeHandle node, string configNamespace)
+  : m_node(node)
+  , m_namespace(configNamespace)
+  , m_port("/dev/ttyACM0")
+  , m_baud(DEFAULT_BAUD)
+  , m_adcTopic("adc")
+  , m_pwmTopic("pwm")
+  , m_reconnect(DEFAULT_RECONNECT)
+  , m_fd(-1)
+  , m_reader(m_readBuffer, BUFFER_SIZE)
+  , m_writer(m_writeBuffer, BUFFER_SIZE)
+  , m_running(true)
+{
+}
+
+serialTransport::~serialTransport()
+{
+  closePort();
+}
+
+//
+// Initialization
+//
+
+bool serialTransport::configure()
+{
+  XmlRpc::XmlRpcValue settings;
+
+  if (!ros::param::get(m_namespace, settings))
+  {
+    ROS_WARN("no serial settings found in %s, using %s at %d", m_namespace.c_str(), m_port.c_str(), m_baud);
+    return true;
+  }
+
+  controllerUtilities::getSetting(settings, "port", m_port);
+  controllerUtilities::getSetting(settings, "baud", m_baud);
+  controllerUtilities::getSetting(settings, "adc_topic", m_adcTopic);
+  controllerUtilities::getSetting(settings, "pwm_topic", m_pwmTopic);
+  controllerUtilities::getSetting(settings, "reconnect", m_reconnect);
+
+  if (!getSpeed(m_baud))
+  {
+    ROS_ERROR("unsupported serial speed %d", m_baud);
+    return false;
+  }
+
+  return true;
+}
+
+bool serialTransport::init()
+{
+  if (!openPort()) return false;
+
+  m_adcPub = m_node.advertise<Adc>(m_adcTopic, QUEUE_SIZE);
+
+  m_pwmSub = m_node.subscribe<Pwm>(
+    m_pwmTopic, QUEUE_SIZE, &serialTransport::pwmCallback, this,
+    ros::TransportHints().tcpNoDelay());
+
+  ROS_INFO("  initialized serial transport on %s at %d: %s -> %s, %s -> %s",
+    m_port.c_str(), m_baud, m_pwmTopic.c_str(), m_port.c_str(), m_port.c_str(), m_adcTopic.c_str());
+
+  return true;
+}
+
+bool serialTransport::openPort()
+{
+  m_fd = open(m_port.c_str(), O_RDWR | O_NOCTTY);
+
+  if (m_fd == -1)
+  {
+    ROS_ERROR("failed to open %s: %s", m_port.c_str(), strerror(errno));
+    return false;
+  }
+
+  termios options;
+  tcgetattr(m_fd, &options);
+  cfmakeraw(&options);
+  cfsetispeed(&options, getSpeed(m_baud));
+  cfsetospeed(&options, getSpeed(m_baud));
+
+  // Return whatever arrived within 100 ms so the read loop can stop
+  options.c_cc[VMIN] = 0;
+  options.c_cc[VTIME] = 1;
+
+  if (tcsetattr(m_fd, TCSANOW, &options) == -1)
+  {
+    ROS_ERROR("failed to configure %s: %s", m_port.c_str(), strerror(errno));
+    closePort();
+    return false;
+  }
+
+  tcflush(m_fd, TCIOFLUSH);
+
+  return true;
+}
+
+void serialTransport::closePort()
+{
+  if (m_fd == -1) return;
+
+  close(m_fd);
+  m_fd = -1;
+}
+
+//
+// Read loop
+//
+
+void serialTransport::run()
+{
+  uint8_t received[64];
+  ros::WallTime lastRequest;
+
+  while (m_running && ros::ok())
+  {
+    if (m_fd == -1)
+    {
+      // Device was unplugged or reset, wait for it to come back
+      ros::WallDuration(m_reconnect).sleep();
+
+      lock_guard<mutex> lock(m_writeLock);
+      if (!openPort()) continue;
+
+      m_reader.reset();
+    }
+
+    ros::WallTime now = ros::WallTime::now();
+
+    if ((now - m_lastReading).toSec() >= m_reconnect &&
+        (now - lastRequest).toSec() >= m_reconnect)
+    {
+      requestTopics();
+      lastRequest = now;
+    }
+
+    ssize_t size = read(m_fd, received, sizeof(received));
+
+    if (size < 0 && errno != EINTR && errno != EAGAIN)
+    {
+      ROS_ERROR("lost %s: %s", m_port.c_str(), strerror(errno));
+
+      lock_guard<mutex> lock(m_writeLock);
+      closePort();
+      continue;
+    }
+
+    for (ssize_t index = 0; index < size; index++)
+    {
+      if (m_reader.push(received[index])) dispatch();
+    }
+  }
+
+  // Tell the device to turn off outputs
+  lock_guard<mutex> lock(m_writeLock);
+  send(TOPIC_TX_STOP, 0);
+}
+
+void serialTransport::shutdown()
+{
+  m_running = false;
+}
+
+void serialTransport::dispatch()
+{
+  uint16_t topic = m_reader.getTopic();
+
+  if (topic == TOPIC_ADC)
+  {
+    receiveAdc();
+  }
+  else if (topic == TOPIC_PUBLISHER || topic == TOPIC_SUBSCRIBER)
+  {
+    receiveTopicInfo();
+  }
+  else if (topic == TOPIC_TIME)
+  {
+    receiveTime();
+  }
+}
+
+void serialTransport::requestTopics()
+{
+  lock_guard<mutex> lock(m_writeLock);
+  send(TOPIC_PUBLISHER, 0);
+}
+
+void serialTransport::receiveTopicInfo()
+{
+  uint16_t topic = 0;
+  string name, type, md5;
+
+  try
+  {
+    ros::serialization::IStream stream(
+      const_cast<uint8_t*>(m_reader.getPayload()), m_reader.getLength());
+
+    ros::serialization::deserialize(stream, topic);
+    ros::serialization::deserialize(stream, name);
+    ros::serialization::deserialize(stream, type);
+    ros::serialization::deserialize(stream, md5);
+  }
+  catch (ros::serialization::StreamOverrunException&)
+  {
+    ROS_WARN("malformed topic description from %s", m_port.c_str());
+    return;
+  }
+
+  const char* expected =
+    topic == TOPIC_ADC ? ros::message_traits::md5sum<Adc>() :
+    topic == TOPIC_PWM ? ros::message_traits::md5sum<Pwm>() :
+    NULL;
+
+  if (!expected)
+  {
+    ROS_WARN("device topic %s (%s) on unknown id %d ignored", name.c_str(), type.c_str(), topic);
+  }
+  else if (md5 != expected)
+  {
+    ROS_ERROR("device %s message %s does not match this build, rebuild firmware", name.c_str(), type.c_str());
+  }
+  else
+  {
+    ROS_INFO("device connected: %s %s", name.c_str(), type.c_str());
+  }
+}
+
+void serialTransport::receiveAdc()
+{
+  // Published by pointer so nodelets in this process share it
+  Adc::Ptr msg = m_adc.acquire();
+
+  try
+  {
+    ros::serialization::IStream stream(
+      const_cast<uint8_t*>(m_reader.getPayload()), m_reader.getLength());
+
+    ros::serialization::deserialize(stream, *msg);
+  }
+  catch (ros::serialization::StreamOverrunException&)
+  {
+    ROS_WARN("malformed readings from %s", m_port.c_str());
+    return;
+  }
+
+  m_lastReading = ros::WallTime::now();
+  m_adcPub.publish(msg);
+}
+
+void serialTransport::receiveTime()
+{
+  ros::Time now = ros::Time::now();
+
+  lock_guard<mutex> lock(m_writeLock);
+
+  send(TOPIC_TIME, serializeTime(
+    now.sec, now.nsec, m_writer.getPayload(), m_writer.getCapacity()));
+}
+
+//
+// Output requests
+//
+
+void serialTransport::pwmCallback(const Pwm::ConstPtr& msg)
+{
+  uint32_t length = ros::serialization::serializationLength(*msg);
+
+  lock_guard<mutex> lock(m_writeLock);
+
+  if (int(length) > m_writer.getCapacity())
+  {
+    ROS_WARN("output request of %u bytes too large for %s", length, m_port.c_str());
+    return;
+  }
+
+  ros::serialization::OStream stream(m_writer.getPayload(), length);
+  ros::serialization::serialize(stream, *msg);
+
+  send(TOPIC_PWM, length);
+}
+
+void serialTransport::send(uint16_t topic, int length)
+{
+  if (m_fd == -1 || length < 0) return;
+
+  int size = m_writer.finish(topic, length);
+  const uint8_t* frame = m_writer.getFrame();
+
+  while (size > 0)
+  {
+    ssize_t written = write(m_fd, frame, size);
+
+    if (written < 0)
+    {
+      if (errno == EINTR) continue;
+
+      ROS_WARN("failed to write to %s: %s", m_port.c_str(), strerror(errno));
+      return;
+    }
+
+    frame += written;
+    size -= written;
+  }
+}
@@ -0,0 +1,160 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ serialTransport.h
+
+ Serial transport for device readings and output requests
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <ros/ros.h>
+#include <str1ker/Adc.h>
+#include <str1ker/Pwm.h>
+#include "analog/core/framing.h"
+#include "messagePool.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| serialTransport class
+\*----------------------------------------------------------*/
+
+//
+// Host side of the device serial protocol, replacing the rosserial
+// bridge. Readings are published and output requests received by
+// pointer, so nodes loaded into the same nodelet manager exchange
+// them without serializing.
+//
+
+class serialTransport
+{
+private:
+  // Default serial speed, must match the firmware
+  const int DEFAULT_BAUD = 57600;
+
+  // Default time without readings before requesting topics again
+  const double DEFAULT_RECONNECT = 1.0;
+
+  // Publish and subscribe queue size
+  const int QUEUE_SIZE = 8;
+
+  // Frame buffer size, larger than the biggest frame the device sends
+  static const int BUFFER_SIZE = 512;
+
+private:
+  // ROS node
+  ros::NodeHandle m_node;
+
+  // The namespace for loading settings
+  std::string m_namespace;
+
+  // Serial port device path
+  std::string m_port;
+
+  // Serial port speed
+  int m_baud;
+
+  // Topic to publish readings on
+  std::string m_adcTopic;
+
+  // Topic to receive output requests on
+  std::string m_pwmTopic;
+
+  // Time without readings before requesting topics again
+  double m_reconnect;
+
+  // Serial port, -1 if not open
+  int m_fd;
+
+  // Readings publisher
+  ros::Publisher m_adcPub;
+
+  // Output request subscriber
+  ros::Subscriber m_pwmSub;
+
+  // Readings reused once subscribers release them
+  messagePool<Adc, 8> m_adc;
+
+  // Received frame parser, owned by the read loop
+  uint8_t m_readBuffer[BUFFER_SIZE];
+  frameReader m_reader;
+
+  // Frame buffer for sending, shared by the read loop and subscriber
+  uint8_t m_writeBuffer[BUFFER_SIZE];
+  frameWriter m_writer;
+  std::mutex m_writeLock;
+
+  // Time of last readings
+  ros::WallTime m_lastReading;
+
+  // Cleared to stop the read loop
+  std::atomic<bool> m_running;
+
+public:
+  serialTransport(ros::NodeHandle node, std::string configNamespace);
+  ~serialTransport();
+
+public:
+  // Load settings
+  bool configure();
+
+  // Open serial port, advertise readings and subscribe to output requests
+  bool init();
+
+  // Receive frames until shutdown
+  void run();
+
+  // Stop read loop from another thread
+  void shutdown();
+
+private:
+  // Open serial port in raw mode
+  bool openPort();
+
+  // Close serial port
+  void closePort();
+
+  // Handle a complete frame
+  void dispatch();
+
+  // Ask the device to describe its topics and start publishing
+  void requestTopics();
+
+  // Check that a device topic matches the message type built into this node
+  void receiveTopicInfo();
+
+  // Publish readings
+  void receiveAdc();
+
+  // Answer device time request
+  void receiveTime();
+
+  // Send output request to the device
+  void pwmCallback(const Pwm::ConstPtr& msg);
+
+  // Frame and write serialized payload, call with write lock held
+  void send(uint16_t topic, int length);
+};
+
+} // namespace str1ker
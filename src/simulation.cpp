@@ -0,0 +1,503 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ simulation.cpp
+
+ Deterministic Full-Stack Simulation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <thread>
+#include <controller_manager/controller_manager.h>
+#include "allocationCounter.h"
+#include "controllerUtilities.h"
+#include "jointTrajectoryController.h"
+#include "simulation.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Helpers
+\*----------------------------------------------------------*/
+
+// Read number that may have been written without decimal point
+static bool toDouble(XmlRpc::XmlRpcValue& value, double& result)
+{
+  if (value.getType() == XmlRpc::XmlRpcValue::TypeDouble)
+    result = static_cast<double>(value);
+  else if (value.getType() == XmlRpc::XmlRpcValue::TypeInt)
+    result = static_cast<int>(value);
+  else
+    return false;
+
+  return true;
+}
+
+/*----------------------------------------------------------*\
+| simulation implementation
+\*----------------------------------------------------------*/
+
+simulation::simulation(
+  ros::NodeHandle node, string hardwareNamespace, string simulationNamespace)
+  : m_node(node)
+  , m_namespace(simulationNamespace)
+  , m_hardware(node, hardwareNamespace)
+  , m_controllerName(DEFAULT_CONTROLLER)
+  , m_trajectoryController(NULL)
+  , m_settle(DEFAULT_SETTLE)
+  , m_timeout(DEFAULT_TIMEOUT)
+  , m_repeat(1)
+  , m_outputFile(NULL)
+  , m_hash(HASH_OFFSET)
+  , m_checkAllocations(false)
+  , m_warmup(DEFAULT_WARMUP)
+  , m_cycle(0)
+  , m_cycleAllocations(0)
+  , m_violations(0)
+  , m_firstViolation(0)
+  , m_maxAllocations(0)
+{
+}
+
+simulation::~simulation()
+{
+  if (m_outputFile) fclose(m_outputFile);
+}
+
+//
+// Initialization
+//
+
+bool simulation::configure()
+{
+  if (!m_hardware.configure()) return false;
+
+  XmlRpc::XmlRpcValue settings;
+
+  if (!ros::param::get(m_namespace, settings))
+  {
+    ROS_ERROR("no simulation settings found in %s", m_namespace.c_str());
+    return false;
+  }
+
+  controllerUtilities::getSetting(settings, "controller", m_controllerName);
+  controllerUtilities::getSetting(settings, "settle", m_settle);
+  controllerUtilities::getSetting(settings, "timeout", m_timeout);
+  controllerUtilities::getSetting(settings, "repeat", m_repeat);
+  controllerUtilities::getSetting(settings, "output", m_output);
+  controllerUtilities::getSetting(settings, "check_allocations", m_checkAllocations);
+  controllerUtilities::getSetting(settings, "warmup", m_warmup);
+
+  return loadTrajectories(settings);
+}
+
+bool simulation::init()
+{
+  if (!m_hardware.init()) return false;
+
+  XmlRpc::XmlRpcValue settings;
+  ros::param::get(m_namespace, settings);
+
+  XmlRpc::XmlRpcValue plantSettings;
+  controllerUtilities::getSubtree(settings, "plant", plantSettings);
+
+  if (!m_plant.configure(m_hardware, plantSettings)) return false;
+
+  if (!m_output.empty())
+  {
+    m_outputFile = fopen(m_output.c_str(), "w");
+
+    if (!m_outputFile)
+    {
+      ROS_ERROR("failed to open %s for simulation output", m_output.c_str());
+      return false;
+    }
+
+    fprintf(m_outputFile, "time");
+
+    for (size_t joint = 0; joint < m_plant.getJointCount(); joint++)
+    {
+      const char* name = m_plant.getJointName(joint).c_str();
+      fprintf(m_outputFile, ",%s_pos,%s_vel", name, name);
+    }
+
+    fprintf(m_outputFile, ",allocations\n");
+  }
+
+  // Subscribe like delay compensation does, publishing to subscribers must not allocate
+  if (m_checkAllocations)
+  {
+    m_statusSub = m_node.subscribe("hardware_status", 1, &simulation::statusCallback, this);
+  }
+
+  // Everything from here on reads the simulated clock
+  m_time = ros::Time(START_TIME);
+  m_period = ros::Duration(1.0 / m_hardware.getRate());
+  ros::Time::setNow(m_time);
+
+  return startController();
+}
+
+bool simulation::loadTrajectories(XmlRpc::XmlRpcValue& settings)
+{
+  if (!settings.hasMember("trajectories") ||
+      settings["trajectories"].getType() != XmlRpc::XmlRpcValue::TypeArray)
+  {
+    ROS_ERROR("no trajectories found in %s", m_namespace.c_str());
+    return false;
+  }
+
+  XmlRpc::XmlRpcValue& trajectories = settings["trajectories"];
+
+  for (int trajectoryIndex = 0; trajectoryIndex < trajectories.size(); trajectoryIndex++)
+  {
+    XmlRpc::XmlRpcValue& source = trajectories[trajectoryIndex];
+    trajectory_msgs::JointTrajectory trajectory;
+
+    if (source.getType() != XmlRpc::XmlRpcValue::TypeStruct ||
+        !source.hasMember("joints") || !source.hasMember("points") ||
+        source["joints"].getType() != XmlRpc::XmlRpcValue::TypeArray ||
+        source["points"].getType() != XmlRpc::XmlRpcValue::TypeArray)
+    {
+      ROS_ERROR("trajectory %d must have joints and points", trajectoryIndex);
+      return false;
+    }
+
+    for (int jointIndex = 0; jointIndex < source["joints"].size(); jointIndex++)
+      trajectory.joint_names.push_back(static_cast<string>(source["joints"][jointIndex]));
+
+    for (int pointIndex = 0; pointIndex < source["points"].size(); pointIndex++)
+    {
+      XmlRpc::XmlRpcValue& sourcePoint = source["points"][pointIndex];
+      trajectory_msgs::JointTrajectoryPoint point;
+      double time = 0.0;
+
+      if (sourcePoint.getType() != XmlRpc::XmlRpcValue::TypeStruct ||
+          !sourcePoint.hasMember("time") || !sourcePoint.hasMember("positions") ||
+          !toDouble(sourcePoint["time"], time) ||
+          sourcePoint["positions"].size() != int(trajectory.joint_names.size()))
+      {
+        ROS_ERROR("trajectory %d point %d must have time and a position for each joint",
+          trajectoryIndex, pointIndex);
+
+        return false;
+      }
+
+      point.time_from_start = ros::Duration(time);
+      point.positions.resize(trajectory.joint_names.size());
+
+      for (size_t jointIndex = 0; jointIndex < trajectory.joint_names.size(); jointIndex++)
+      {
+        if (!toDouble(sourcePoint["positions"][int(jointIndex)], point.positions[jointIndex]))
+        {
+          ROS_ERROR("trajectory %d point %d has invalid position", trajectoryIndex, pointIndex);
+          return false;
+        }
+      }
+
+      trajectory.points.push_back(point);
+    }
+
+    m_trajectories.push_back(trajectory);
+  }
+
+  return true;
+}
+
+bool simulation::startController()
+{
+  controller_manager::ControllerManager& manager = m_hardware.getControllerManager();
+
+  if (!manager.loadController(m_controllerName))
+  {
+    ROS_ERROR("failed to load %s", m_controllerName.c_str());
+    return false;
+  }
+
+  // Switching waits for the update loop, which is this thread
+  vector<string> start = { m_controllerName };
+  vector<string> stop;
+
+  auto switching = async(launch::async, [&]() {
+    return manager.switchController(
+      start, stop, controller_manager_msgs::SwitchController::Request::STRICT);
+  });
+
+  // Controllers are idle while switching, the clock does not advance
+  while (switching.wait_for(chrono::milliseconds(1)) != future_status::ready)
+    manager.update(m_time, ros::Duration(0.0));
+
+  if (!switching.get())
+  {
+    ROS_ERROR("failed to start %s", m_controllerName.c_str());
+    return false;
+  }
+
+  m_trajectoryController = dynamic_cast<jointTrajectoryController*>(
+    manager.getControllerByName(m_controllerName));
+
+  if (!m_trajectoryController)
+  {
+    ROS_ERROR("%s is not a str1ker trajectory controller", m_controllerName.c_str());
+    return false;
+  }
+
+  // Match controller joints to simulated joints by name to measure tracking error
+  size_t jointCount = m_trajectoryController->getJointCount();
+
+  m_plantJoints.assign(jointCount, -1);
+  m_reference.resize(jointCount);
+  m_tracking.resize(jointCount);
+  m_totalTracking.resize(jointCount);
+
+  for (size_t jointIndex = 0; jointIndex < jointCount; jointIndex++)
+  {
+    for (size_t joint = 0; joint < m_plant.getJointCount(); joint++)
+    {
+      if (m_plant.getJointName(joint) == m_trajectoryController->getJointName(jointIndex))
+        m_plantJoints[jointIndex] = int(joint);
+    }
+  }
+
+  return true;
+}
+
+//
+// Simulation
+//
+
+bool simulation::run()
+{
+  size_t completed = 0;
+  size_t executed = 0;
+  auto start = chrono::steady_clock::now();
+
+  // Let encoder filters settle with joints at rest
+  while (m_time < ros::Time(START_TIME + m_settle))
+    step();
+
+  for (int round = 0; round < m_repeat && ros::ok(); round++)
+  {
+    for (size_t index = 0; index < m_trajectories.size() && ros::ok(); index++)
+    {
+      if (execute(m_trajectories[index], index)) completed++;
+      executed++;
+    }
+  }
+
+  double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  double simulated = (m_time - ros::Time(START_TIME)).toSec();
+
+  ROS_INFO("completed %lu of %lu trajectories, simulated %.3f sec in %.3f sec (%.1fx)",
+    (unsigned long)completed,
+    (unsigned long)executed,
+    simulated,
+    elapsed,
+    elapsed > 0.0 ? simulated / elapsed : 0.0);
+
+  reportTracking("all trajectories", m_totalTracking);
+
+  ROS_INFO("state hash %016llx", (unsigned long long)m_hash);
+
+  if (m_violations)
+  {
+    ROS_ERROR("%llu of %llu update cycles allocated after warm-up, first at cycle %llu, at most %llu allocations",
+      (unsigned long long)m_violations,
+      (unsigned long long)(m_cycle - min<uint64_t>(m_cycle, m_warmup)),
+      (unsigned long long)m_firstViolation,
+      (unsigned long long)m_maxAllocations);
+  }
+  else if (m_checkAllocations)
+  {
+    ROS_INFO("no allocations in %llu update cycles after warm-up",
+      (unsigned long long)(m_cycle - min<uint64_t>(m_cycle, m_warmup)));
+  }
+
+  return completed == executed && !m_violations;
+}
+
+bool simulation::execute(const trajectory_msgs::JointTrajectory& trajectory, size_t index)
+{
+  ros::Time start = m_time;
+  double duration = trajectory.points.empty()
+    ? 0.0
+    : trajectory.points.back().time_from_start.toSec();
+
+  ros::Time deadline = start + ros::Duration(duration + m_timeout);
+
+  m_trajectoryController->parseTrajectory(trajectory, m_time);
+
+  fill(m_tracking.begin(), m_tracking.end(), tracking_t());
+
+  // The controller starts the parsed goal on its next update
+  do
+  {
+    step();
+    track((m_time - start).toSec());
+  }
+  while (m_trajectoryController->isExecuting() && m_time < deadline);
+
+  bool completed = !m_trajectoryController->isExecuting();
+
+  if (!completed)
+  {
+    // Stop so the next trajectory starts from rest
+    m_trajectoryController->endTrajectory();
+    step();
+  }
+
+  ROS_INFO("trajectory %lu %s after %.3f sec",
+    (unsigned long)index,
+    completed ? "completed" : "timed out",
+    (m_time - start).toSec());
+
+  reportTracking("trajectory", m_tracking);
+
+  return completed;
+}
+
+void simulation::step()
+{
+  ros::Time::setNow(m_time);
+
+  m_hardware.feed(m_plant.sample(), m_time);
+
+  // Only the update loop runs on the real-time thread in hardware
+  allocationCounter::counts_t before = allocationCounter::get();
+  m_hardware.update(m_time);
+  allocationCounter::counts_t after = allocationCounter::get();
+
+  checkAllocations(after.allocations - before.allocations);
+
+  m_plant.step(m_period.toSec());
+
+  m_time += m_period;
+
+  capture();
+}
+
+void simulation::track(double trajectoryTime)
+{
+  if (m_trajectoryController->sampleTrajectory(trajectoryTime, m_reference) < 0) return;
+
+  for (size_t jointIndex = 0; jointIndex < m_plantJoints.size(); jointIndex++)
+  {
+    if (m_plantJoints[jointIndex] < 0) continue;
+
+    double error = abs(m_reference[jointIndex] - m_plant.getPos(m_plantJoints[jointIndex]));
+
+    m_tracking[jointIndex].add(error);
+    m_totalTracking[jointIndex].add(error);
+  }
+}
+
+void simulation::reportTracking(const char* label, const vector<tracking_t>& tracking)
+{
+  for (size_t jointIndex = 0; jointIndex < tracking.size(); jointIndex++)
+  {
+    if (!tracking[jointIndex].samples) continue;
+
+    ROS_INFO("%s %s tracking error rms %.6g max %.6g",
+      label,
+      m_trajectoryController->getJointName(jointIndex).c_str(),
+      sqrt(tracking[jointIndex].squared / tracking[jointIndex].samples),
+      tracking[jointIndex].max);
+  }
+}
+
+void simulation::statusCallback(const HardwareStatus::ConstPtr& msg)
+{
+}
+
+void simulation::checkAllocations(uint64_t allocations)
+{
+  uint64_t cycle = m_cycle++;
+  m_cycleAllocations = allocations;
+
+  if (!m_checkAllocations || cycle < uint64_t(m_warmup) || !allocations) return;
+
+  if (!m_violations++)
+  {
+    m_firstViolation = cycle;
+
+    ROS_ERROR("update cycle %llu at %.6f sec allocated %llu times",
+      (unsigned long long)m_firstViolation,
+      (m_time - ros::Time(START_TIME)).toSec(),
+      (unsigned long long)allocations);
+  }
+
+  m_maxAllocations = max(m_maxAllocations, allocations);
+}
+
+void simulation::capture()
+{
+  for (size_t joint = 0; joint < m_plant.getJointCount(); joint++)
+  {
+    double pos = m_plant.getPos(joint);
+    double vel = m_plant.getVelocity(joint);
+
+    hash(&pos, sizeof(pos));
+    hash(&vel, sizeof(vel));
+  }
+
+  if (!m_outputFile) return;
+
+  fprintf(m_outputFile, "%.6f", (m_time - ros::Time(START_TIME)).toSec());
+
+  for (size_t joint = 0; joint < m_plant.getJointCount(); joint++)
+    fprintf(m_outputFile, ",%.17g,%.17g", m_plant.getPos(joint), m_plant.getVelocity(joint));
+
+  fprintf(m_outputFile, ",%llu\n", (unsigned long long)m_cycleAllocations);
+}
+
+void simulation::hash(const void* data, size_t size)
+{
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+  for (size_t n = 0; n < size; n++)
+  {
+    m_hash ^= bytes[n];
+    m_hash *= HASH_PRIME;
+  }
+}
+
+/*----------------------------------------------------------*\
+| Node entry point implementation
+\*----------------------------------------------------------*/
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "simulation");
+
+  ros::NodeHandle node;
+  simulation sim(node, "robot", "simulation");
+
+  if (!sim.configure() || !sim.init())
+  {
+    ROS_FATAL("simulation failed to initialize");
+    return 1;
+  }
+
+  return sim.run() ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ simulation.h
+
+ Deterministic Full-Stack Simulation
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <ros/ros.h>
+#include <trajectory_msgs/JointTrajectory.h>
+#include "hardware.h"
+#include "plant.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| Declarations
+\*----------------------------------------------------------*/
+
+template <class hardwareInterface> class trajectoryController;
+typedef trajectoryController<hardware_interface::VelocityJointInterface> jointTrajectoryController;
+
+/*----------------------------------------------------------*\
+| simulation class
+\*----------------------------------------------------------*/
+
+class simulation
+{
+private:
+  // Position tracking error accumulated for one joint
+  struct tracking_t
+  {
+    double squared = 0.0;
+    double max = 0.0;
+    uint64_t samples = 0;
+
+    inline void add(double error)
+    {
+      squared += error * error;
+      max = std::max(max, error);
+      samples++;
+    }
+  };
+
+private:
+  // Simulated clock start, ROS treats time 0 as unset
+  const double START_TIME = 1.0;
+
+  // Default time to let encoder filters settle before the first trajectory
+  const double DEFAULT_SETTLE = 1.0;
+
+  // Default time allowed past the end of each trajectory
+  const double DEFAULT_TIMEOUT = 5.0;
+
+  // Default number of cycles allowed to allocate before checking
+  const int DEFAULT_WARMUP = 100;
+
+  // Default trajectory controller to drive
+  const char* DEFAULT_CONTROLLER = "arm_velocity_controller";
+
+  // FNV-1a state hash parameters
+  const uint64_t HASH_OFFSET = 14695981039346656037ULL;
+  const uint64_t HASH_PRIME = 1099511628211ULL;
+
+private:
+  // ROS node
+  ros::NodeHandle m_node;
+
+  // The namespace for loading simulation settings
+  std::string m_namespace;
+
+  // Hardware interface under test, fed by the plant instead of the device
+  hardware m_hardware;
+
+  // Simulated joints
+  plant m_plant;
+
+  // Trajectory controller started in the controller manager
+  std::string m_controllerName;
+  jointTrajectoryController* m_trajectoryController;
+
+  // Simulated joint driven by each trajectory controller joint, -1 if not simulated
+  std::vector<int> m_plantJoints;
+
+  // Reference positions sampled from the executing trajectory
+  std::vector<double> m_reference;
+
+  // Tracking error of each controller joint over the executing trajectory and over the run
+  std::vector<tracking_t> m_tracking;
+  std::vector<tracking_t> m_totalTracking;
+
+  // Time to let encoder filters settle
+  double m_settle;
+
+  // Time allowed past the end of each trajectory
+  double m_timeout;
+
+  // Number of times to execute all trajectories
+  int m_repeat;
+
+  // Trajectories to execute
+  std::vector<trajectory_msgs::JointTrajectory> m_trajectories;
+
+  // Per-cycle state output, disabled if empty
+  std::string m_output;
+  FILE* m_outputFile;
+
+  // Simulated clock
+  ros::Time m_time;
+  ros::Duration m_period;
+
+  // Hash of every simulated state, equal across runs with identical inputs
+  uint64_t m_hash;
+
+  // Whether any heap allocation in the update loop fails the run
+  bool m_checkAllocations;
+
+  // Status subscription so hardware serializes status as when monitored, never spun
+  ros::Subscriber m_statusSub;
+
+  // Cycles allowed to allocate while buffers and caches fill
+  int m_warmup;
+
+  // Update cycles executed
+  uint64_t m_cycle;
+
+  // Allocations made by the last update cycle
+  uint64_t m_cycleAllocations;
+
+  // Update cycles that allocated after warm-up
+  uint64_t m_violations;
+
+  // First and worst update cycle that allocated after warm-up
+  uint64_t m_firstViolation;
+  uint64_t m_maxAllocations;
+
+public:
+  simulation(ros::NodeHandle node, std::string hardwareNamespace, std::string simulationNamespace);
+  ~simulation();
+
+public:
+  // Load hardware, plant and trajectory settings
+  bool configure();
+
+  // Initialize hardware and start trajectory controller
+  bool init();
+
+  // Execute all trajectories, returns false if any did not complete
+  // or the update loop allocated when checking allocations
+  bool run();
+
+private:
+  // Parse trajectories from settings
+  bool loadTrajectories(XmlRpc::XmlRpcValue& settings);
+
+  // Load and start trajectory controller without a spinner
+  bool startController();
+
+  // Execute one trajectory, returns false if it timed out
+  bool execute(const trajectory_msgs::JointTrajectory& trajectory, size_t index);
+
+  // Advance plant, hardware and controllers by one period
+  void step();
+
+  // Accumulate simulated position error from the trajectory reference
+  void track(double trajectoryTime);
+
+  // Log tracking error of each controller joint
+  void reportTracking(const char* label, const std::vector<tracking_t>& tracking);
+
+  // Count allocations made by the last update cycle
+  void checkAllocations(uint64_t allocations);
+
+  // Status subscription callback, only exists to create a subscriber
+  void statusCallback(const HardwareStatus::ConstPtr& msg);
+
+  // Add state to hash and output
+  void capture();
+
+  // Mix value into state hash
+  void hash(const void* data, size_t size);
+};
+
+} // namespace str1ker
+
+/*----------------------------------------------------------*\
+| Node entry point
+\*----------------------------------------------------------*/
+
+int main(int argc, char** argv);
@@ -24,6 +24,10 @@
 #include "robot.h"
 #include "solenoid.h"
 #include "controllerFactory.h"
+#include "controllerUtilities.h"
+#include "hardwareUtilities.h"
+#include "trace.h"
+#include "recorder.h"
 
 /*----------------------------------------------------------*\
 | Namespace
@@ -57,44 +61,89 @@ bool solenoid::configure()
 {
     controller::configure();
 
-    if (!ros::param::get(getChildPath("topic"), m_topic))
+    if (!getSetting("topic", m_topic))
         ROS_WARN("%s did not specify output topic, using %s", getPath().c_str(), m_topic.c_str());
 
-    if (!ros::param::get(getChildPath("channel"), m_channel))
+    if (!getSetting("channel", m_channel))
         ROS_WARN("%s did not specify output channel, using %d", getPath().c_str(), m_channel);
 
-    if (!ros::param::get(getChildPath("triggerSeconds"), m_triggerDurationSec))
+    if (!getSetting("triggerSeconds", m_triggerDurationSec))
         ROS_WARN("%s did not specify trigger duration, using %g sec", getPath().c_str(), m_triggerDurationSec);
 
+    m_staged = m_triggerDurationSec;
+
+    return true;
+}
+
+bool solenoid::stage(XmlRpc::XmlRpcValue& settings)
+{
+    // Topic and channel require a restart
+    double staged = m_staged;
+
+    controllerUtilities::getSetting(settings, "triggerSeconds", staged);
+
+    if (staged <= 0.0 || staged > MAX_TRIGGER_DURATION_SEC)
+    {
+        ROS_ERROR("%s trigger duration %g sec is outside (0, %g]", getPath().c_str(), staged, MAX_TRIGGER_DURATION_SEC);
+        return false;
+    }
+
+    m_staged = staged;
+
     return true;
 }
 
+void solenoid::release()
+{
+    m_reload.publish(m_staged);
+}
+
+bool solenoid::commit()
+{
+    return m_reload.consume(m_triggerDurationSec);
+}
+
 bool solenoid::init()
 {
     if (!m_enable) return true;
 
     m_pub = m_node.advertise<Pwm>(m_topic.c_str(), QUEUE_SIZE);
 
+    Pwm prototype;
+    prototype.channels.resize(1);
+    prototype.channels[0].channel = m_channel;
+    prototype.channels[0].mode = PwmChannel::MODE_DIGITAL;
+    prototype.channels[0].value = 1;
+
+    m_pwm.init(prototype);
+
     ROS_INFO("  initialized %s %s on %s channel %d trigger %g sec",
         getPath().c_str(), getType().c_str(), m_topic.c_str(), m_channel, m_triggerDurationSec);
 
     return true;
 }
 
-void solenoid::trigger()
+void solenoid::trigger(double delaySec)
 {
     if (!m_enable) return;
 
-    Pwm msg;
-    msg.channels[0].channel = m_channel;
-    msg.channels[0].mode = PwmChannel::MODE_DIGITAL;
-    msg.channels[0].value = 1;
-    msg.channels[0].duration = uint8_t(m_triggerDurationSec * 1000.0);
+    delaySec = utilities::clamp(delaySec, 0.0, MAX_TRIGGER_DELAY_SEC);
+
+    // Trigger duration is reloadable, channel requires a restart
+    Pwm::Ptr msg = m_pwm.acquire();
+    msg->channels[0].duration = uint8_t(m_triggerDurationSec * 1000.0);
+
+    // Device times the delay so strikes land between update cycles
+    msg->channels[0].delay = uint16_t(delaySec * 1000000.0);
+
+    msg->trace = trace::getContext();
+    trace::instant("pwm", msg->trace);
+    recorder::write(recorder::PWM, *msg);
 
     m_pub.publish(msg);
 
     m_triggered = true;
-    m_resetTime = ros::Time::now() + ros::Duration(m_triggerDurationSec);
+    m_resetTime = ros::Time::now() + ros::Duration(delaySec + m_triggerDurationSec);
 }
 
 bool solenoid::isTriggered()
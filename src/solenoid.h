@@ -24,6 +24,8 @@
 #include <string>
 #include <str1ker/Pwm.h>
 #include "controller.h"
+#include "configSnapshot.h"
+#include "messagePool.h"
 
 /*----------------------------------------------------------*\
 | Namespace
@@ -45,6 +47,12 @@ private:
     // Default trigger duration
     const double DEFAULT_TRIGGER_DURATION_SEC = 0.023;
 
+    // Longest trigger duration the firmware accepts
+    const double MAX_TRIGGER_DURATION_SEC = 0.255;
+
+    // Longest trigger delay the firmware accepts
+    const double MAX_TRIGGER_DELAY_SEC = 0.065535;
+
 private:
     // Publishing queue size
     const int QUEUE_SIZE = 4;
@@ -61,12 +69,21 @@ private:
     // Publisher to solenoid driver
     ros::Publisher m_pub;
 
+    // PWM messages sized once in init and reused for each trigger
+    messagePool<Pwm> m_pwm;
+
     // Triggered status
     bool m_triggered;
 
     // Reset time if triggered
     ros::Time m_resetTime;
 
+    // Trigger duration staged by reload, owned by reload thread
+    double m_staged;
+
+    // Trigger duration handed from reload thread to update loop
+    configSnapshot<double> m_reload;
+
 public:
     solenoid(ros::NodeHandle node, std::string path);
 
@@ -81,8 +98,17 @@ public:
     // Update
     virtual void update(ros::Time time, ros::Duration period);
 
-    // Momentary trigger
-    void trigger();
+    // Validate reloaded settings
+    virtual bool stage(XmlRpc::XmlRpcValue& settings);
+
+    // Hand staged settings to update loop
+    virtual void release();
+
+    // Apply reloaded settings
+    virtual bool commit();
+
+    // Momentary trigger, optionally delayed by the device
+    void trigger(double delaySec = 0.0);
     bool isTriggered();
 
 public:
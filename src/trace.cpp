@@ -0,0 +1,214 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ trace.cpp
+
+ Latency Tracing
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include "trace.h"
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+using namespace str1ker;
+using namespace std;
+
+/*----------------------------------------------------------*\
+| Variables
+\*----------------------------------------------------------*/
+
+atomic<bool> trace::s_enabled(false);
+atomic<uint32_t> trace::s_context(0);
+atomic<uint32_t> trace::s_lastId(0);
+atomic<size_t> trace::s_next(0);
+atomic<uint64_t> trace::s_dropped(0);
+atomic<uint32_t> trace::s_threads(0);
+vector<trace::event_t> trace::s_events;
+
+/*----------------------------------------------------------*\
+| trace implementation
+\*----------------------------------------------------------*/
+
+//
+// Lifecycle
+//
+
+void trace::enable(size_t capacity)
+{
+  // Allocate once, before the update loop starts recording
+  if (s_events.size() != capacity)
+  {
+    vector<event_t> events(capacity);
+    s_events.swap(events);
+    s_next = 0;
+  }
+
+  s_enabled.store(true, memory_order_release);
+}
+
+void trace::disable()
+{
+  s_enabled.store(false, memory_order_release);
+}
+
+uint32_t trace::begin()
+{
+  if (!isEnabled()) return 0;
+
+  // Skip 0 on wrap around, it means "not traced"
+  uint32_t id = s_lastId.fetch_add(1, memory_order_relaxed) + 1;
+  if (!id) id = s_lastId.fetch_add(1, memory_order_relaxed) + 1;
+
+  return id;
+}
+
+//
+// Recording
+//
+
+uint64_t trace::now()
+{
+  return chrono::duration_cast<chrono::microseconds>(
+    chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void trace::span(const char* name, uint32_t id, uint64_t start, uint64_t end)
+{
+  if (!isEnabled()) return;
+
+  record(name, id, start, end > start ? end - start : 0, false);
+}
+
+void trace::instant(const char* name, uint32_t id)
+{
+  if (!isEnabled()) return;
+
+  record(name, id, now(), 0, true);
+}
+
+void trace::record(const char* name, uint32_t id, uint64_t start, uint64_t duration, bool isInstant)
+{
+  size_t index = s_next.fetch_add(1, memory_order_relaxed);
+
+  if (index >= s_events.size())
+  {
+    s_dropped.fetch_add(1, memory_order_relaxed);
+    return;
+  }
+
+  event_t& event = s_events[index];
+  event.name = name;
+  event.id = id;
+  event.thread = getThread();
+  event.start = start;
+  event.duration = duration;
+  event.isInstant = isInstant;
+  event.ready.store(true, memory_order_release);
+}
+
+uint32_t trace::getThread()
+{
+  static thread_local uint32_t thread = s_threads.fetch_add(1, memory_order_relaxed) + 1;
+  return thread;
+}
+
+uint64_t trace::getDropped()
+{
+  return s_dropped.load(memory_order_relaxed);
+}
+
+//
+// Export
+//
+
+bool trace::save(const string& path)
+{
+  FILE* file = fopen(path.c_str(), "w");
+  if (!file) return false;
+
+  // Collect completed events
+  size_t count = min(s_next.load(memory_order_acquire), s_events.size());
+  vector<const event_t*> events;
+  events.reserve(count);
+
+  for (size_t index = 0; index < count; index++)
+  {
+    if (s_events[index].ready.load(memory_order_acquire))
+      events.push_back(&s_events[index]);
+  }
+
+  sort(events.begin(), events.end(), [](const event_t* a, const event_t* b) {
+    return a->start < b->start;
+  });
+
+  // Number of events per request to place flow arrows between them
+  map<uint32_t, size_t> totals;
+  map<uint32_t, size_t> seen;
+
+  for (const event_t* event : events)
+  {
+    if (event->id) totals[event->id]++;
+  }
+
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+  bool first = true;
+
+  for (const event_t* event : events)
+  {
+    fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"str1ker\",\"pid\":1,\"tid\":%u,\"ts\":%llu,",
+      first ? "" : ",\n",
+      event->name,
+      event->thread,
+      (unsigned long long)event->start);
+
+    if (event->isInstant)
+      fprintf(file, "\"ph\":\"i\",\"s\":\"t\",");
+    else
+      fprintf(file, "\"ph\":\"X\",\"dur\":%llu,", (unsigned long long)event->duration);
+
+    fprintf(file, "\"args\":{\"id\":%u}}", event->id);
+    first = false;
+
+    if (!event->id) continue;
+
+    // Connect spans of the same request across threads
+    size_t total = totals[event->id];
+    size_t index = ++seen[event->id];
+
+    if (total < 2) continue;
+
+    const char* phase = index == 1 ? "s" : index == total ? "f" : "t";
+
+    fprintf(file, ",\n{\"name\":\"request\",\"cat\":\"str1ker\",\"pid\":1,\"tid\":%u,\"ts\":%llu,"
+      "\"ph\":\"%s\",%s\"id\":%u}",
+      event->thread,
+      (unsigned long long)event->start,
+      phase,
+      index == total ? "\"bp\":\"e\"," : "",
+      event->id);
+  }
+
+  fprintf(file, "\n]}\n");
+
+  return fclose(file) == 0;
+}
@@ -0,0 +1,183 @@
+/*
+                                                                                     ███████                  
+ ████████████  ████████████   ████████████       █  █████████████  █           █  ███       ███  ████████████ 
+█              █ █           █            █    █ █  █              █        ███      ███████    █            █
+ ████████████  █   █         █████████████   █   █   █             █   █████      ███       ███ █████████████ 
+             █ █     █       █            █      █    █            ████      █                  █            █
+ ████████████  █       █     █            █      █      █████████  █          █   ███       ███ █            █
+                                                                                     ███████                  
+ trace.h
+
+ Latency Tracing
+ Created 10/18/2026
+
+ Copyright (C) 2026 Valeriy Novytskyy
+ This software is licensed under GNU GPLv3
+*/
+
+#pragma once
+
+/*----------------------------------------------------------*\
+| Includes
+\*----------------------------------------------------------*/
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*----------------------------------------------------------*\
+| Definitions
+\*----------------------------------------------------------*/
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Record a span covering the rest of the enclosing scope
+#define TRACE_SPAN(name, id) \
+  ::str1ker::traceSpan TRACE_CONCAT(__traceSpan, __LINE__)(name, id)
+
+/*----------------------------------------------------------*\
+| Namespace
+\*----------------------------------------------------------*/
+
+namespace str1ker {
+
+/*----------------------------------------------------------*\
+| trace class
+\*----------------------------------------------------------*/
+
+class trace
+{
+public:
+  // Default number of spans kept until saved
+  static const size_t DEFAULT_CAPACITY = 65536;
+
+private:
+  // Completed span, instants have no duration
+  struct event_t
+  {
+    // Static span name
+    const char* name;
+
+    // Correlation ID, 0 if not part of a traced request
+    uint32_t id;
+
+    // Small thread index for the exported timeline
+    uint32_t thread;
+
+    // Start time and duration in microseconds
+    uint64_t start;
+    uint64_t duration;
+
+    // Whether the event is an instant
+    bool isInstant;
+
+    // Set after the writer filled the event
+    std::atomic<bool> ready;
+  };
+
+private:
+  // Whether spans are recorded, checked before any other work
+  static std::atomic<bool> s_enabled;
+
+  // Correlation ID of the request being executed by the update loop
+  static std::atomic<uint32_t> s_context;
+
+  // Last correlation ID handed out
+  static std::atomic<uint32_t> s_lastId;
+
+  // Next event slot to claim
+  static std::atomic<size_t> s_next;
+
+  // Spans that did not fit
+  static std::atomic<uint64_t> s_dropped;
+
+  // Next thread index
+  static std::atomic<uint32_t> s_threads;
+
+  // Event storage, allocated when tracing is enabled
+  static std::vector<event_t> s_events;
+
+public:
+  // Allocate storage and start recording spans
+  static void enable(size_t capacity = DEFAULT_CAPACITY);
+
+  // Stop recording spans
+  static void disable();
+
+  // Determine if spans are recorded
+  static inline bool isEnabled()
+  {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  // Start a traced request, returns correlation ID or 0 if disabled
+  static uint32_t begin();
+
+  // Set correlation ID carried by commands sent from the update loop
+  static inline void setContext(uint32_t id)
+  {
+    s_context.store(id, std::memory_order_relaxed);
+  }
+
+  // Get correlation ID carried by commands sent from the update loop, also set for delay probes
+  static inline uint32_t getContext()
+  {
+    return s_context.load(std::memory_order_relaxed);
+  }
+
+  // Get trace clock time in microseconds
+  static uint64_t now();
+
+  // Record a completed span
+  static void span(const char* name, uint32_t id, uint64_t start, uint64_t end);
+
+  // Record an instant
+  static void instant(const char* name, uint32_t id);
+
+  // Get number of spans that did not fit
+  static uint64_t getDropped();
+
+  // Export recorded spans in Chrome trace event format
+  static bool save(const std::string& path);
+
+private:
+  // Claim and fill an event slot
+  static void record(const char* name, uint32_t id, uint64_t start, uint64_t duration, bool isInstant);
+
+  // Get small index identifying the calling thread
+  static uint32_t getThread();
+};
+
+/*----------------------------------------------------------*\
+| traceSpan class
+\*----------------------------------------------------------*/
+
+class traceSpan
+{
+private:
+  // Static span name
+  const char* m_name;
+
+  // Correlation ID
+  uint32_t m_id;
+
+  // Start time in microseconds, 0 if tracing was disabled
+  uint64_t m_start;
+
+public:
+  inline traceSpan(const char* name, uint32_t id)
+    : m_name(name)
+    , m_id(id)
+    , m_start(trace::isEnabled() ? trace::now() : 0)
+  {
+  }
+
+  inline ~traceSpan()
+  {
+    if (m_start) trace::span(m_name, m_id, m_start, trace::now());
+  }
+};
+
+} // namespace str1ker
@@ -0,0 +1,16 @@
+#!/usr/bin/python3
+
+# Runs the closed loop simulation with the allocation check enabled, using parameters loaded by allocations.test.
+# The simulation exits with a non-zero status if an update cycle allocates after warm-up
+# or a trajectory does not complete, which fails the test.
+
+import subprocess
+import unittest
+import rostest
+
+class checkAllocations(unittest.TestCase):
+    def test_update_loop_does_not_allocate(self):
+        self.assertEqual(subprocess.call(["rosrun", "str1ker", "simulation"]), 0)
+
+if __name__ == "__main__":
+    rostest.rosrun("str1ker", "check_allocations", checkAllocations)